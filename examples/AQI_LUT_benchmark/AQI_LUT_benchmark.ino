@@ -0,0 +1,72 @@
+/* Benchmark the AQI branch-ladder conversions against the lookup tables.
+
+   No sensor is needed. Every integer concentration is converted both ways,
+   the results are checked against each other, and the time per conversion
+   is printed. To make read() use the tables, uncomment PM25AQI_USE_AQI_LUT
+   in Adafruit_AQIUtils.h or pass -DPM25AQI_USE_AQI_LUT as a build flag. A
+   #define in the sketch doesn't reach the library's own compile.
+*/
+
+#include "Adafruit_AQIUtils.h"
+
+Adafruit_AQIUtils utils;
+
+// keeps the compiler from optimizing the loops away
+volatile uint16_t sink;
+
+// Every conversion is timed over its own table's range
+#define CONVERSIONS (3 * 501UL + 605UL)
+
+void setup() {
+  // Wait for serial monitor to open
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println("AQI lookup table benchmark");
+
+  // Check that both methods agree over the whole valid range
+  uint16_t mismatches = 0;
+  for (uint16_t c = 0; c <= 500; c++) {
+    if (utils.pm25_aqi_us(c) != utils.pm25_aqi_us_lut(c)) mismatches++;
+    if (utils.pm25_aqi_china(c) != utils.pm25_aqi_china_lut(c)) mismatches++;
+    if (utils.pm100_aqi_china(c) != utils.pm100_aqi_china_lut(c)) mismatches++;
+  }
+  for (uint16_t c = 0; c <= 604; c++) {
+    if (utils.pm100_aqi_us(c) != utils.pm100_aqi_us_lut(c)) mismatches++;
+  }
+  Serial.print(F("Mismatches: ")); Serial.println(mismatches);
+}
+
+void loop() {
+  uint32_t start, ladder, lut;
+
+  start = micros();
+  for (uint16_t c = 0; c <= 500; c++) {
+    sink = utils.pm25_aqi_us(c);
+    sink = utils.pm25_aqi_china(c);
+    sink = utils.pm100_aqi_china(c);
+  }
+  for (uint16_t c = 0; c <= 604; c++) {
+    sink = utils.pm100_aqi_us(c);
+  }
+  ladder = micros() - start;
+
+  start = micros();
+  for (uint16_t c = 0; c <= 500; c++) {
+    sink = utils.pm25_aqi_us_lut(c);
+    sink = utils.pm25_aqi_china_lut(c);
+    sink = utils.pm100_aqi_china_lut(c);
+  }
+  for (uint16_t c = 0; c <= 604; c++) {
+    sink = utils.pm100_aqi_us_lut(c);
+  }
+  lut = micros() - start;
+
+  Serial.print(F("Branch ladder: ")); Serial.print((float)ladder / CONVERSIONS);
+  Serial.println(F(" us/conversion"));
+  Serial.print(F("Lookup table:  ")); Serial.print((float)lut / CONVERSIONS);
+  Serial.println(F(" us/conversion"));
+  Serial.println();
+
+  delay(2000);
+}
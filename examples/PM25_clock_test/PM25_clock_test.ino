@@ -0,0 +1,126 @@
+/* Checks the library's timeouts without a sensor, and without waiting.
+
+   A virtual clock stands in for millis() and starts just before the 32 bit
+   wraparound. A fake serial port hands over one frame once enough virtual
+   time has passed. begin_UART(), read() and the legacy
+   UARTDevice::uart_read() must give up exactly when their timeouts say,
+   measured in virtual milliseconds, and begin_UART() must work again after
+   giving up. */
+
+#include "Adafruit_PM25AQI.h"
+#include "Adafruit_PM25AQI_UART.h"
+
+#define CLOCK_START 0xFFFFF000UL
+
+// Time only moves when the library sleeps
+class VirtualClock : public Adafruit_PM25AQI_Clock {
+public:
+  uint32_t time = CLOCK_START;
+  uint32_t now() { return time; }
+  void sleep(uint32_t ms) { time += ms; }
+};
+
+VirtualClock virtualClock;
+
+// Serial port that receives one frame, arrival ms into the test
+class FakeSerial : public Stream {
+public:
+  FakeSerial(uint32_t arrival) : _arrival(arrival) {
+    memset(_frame, 0, sizeof(_frame));
+    _frame[0] = 0x42;
+    _frame[1] = 0x4D;
+    _frame[3] = 0x1C;
+    _frame[13] = 35; // pm25_env
+    uint16_t sum = 0;
+    for (uint8_t i = 0; i < 30; i++) sum += _frame[i];
+    _frame[30] = sum >> 8;
+    _frame[31] = sum & 0xFF;
+  }
+  int available() {
+    if (virtualClock.time - CLOCK_START < _arrival) return 0;
+    return sizeof(_frame) - _pos;
+  }
+  int read() { return available() ? _frame[_pos++] : -1; }
+  int peek() { return available() ? _frame[_pos] : -1; }
+  size_t write(uint8_t) { return 1; }
+
+private:
+  uint8_t _frame[32];
+  uint32_t _arrival;
+  uint8_t _pos = 0;
+};
+
+uint8_t failures = 0;
+
+// Virtual milliseconds since the clock was last reset
+uint32_t elapsed() { return virtualClock.time - CLOCK_START; }
+
+void check(const __FlashStringHelper *name, bool passed) {
+  Serial.print(passed ? F("PASS ") : F("FAIL "));
+  Serial.print(name);
+  Serial.print(F(" ("));
+  Serial.print(elapsed());
+  Serial.println(F(" ms)"));
+  if (!passed) failures++;
+}
+
+void setup() {
+  // Wait for serial monitor to open
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println("PM25 AQI virtual clock test");
+
+  {
+    // The frame arrives after 2.5 s, too late for a 1 s timeout
+    virtualClock.time = CLOCK_START;
+    FakeSerial port(2500);
+    Adafruit_PM25AQI aqi;
+    aqi.setClock(&virtualClock);
+    bool ok = aqi.begin_UART(&port, false, 1000);
+    check(F("begin_UART gives up after 1000 ms"), !ok && elapsed() == 1000);
+    // a failed begin must not stop the sketch from trying again
+    ok = aqi.begin_UART(&port, false, 3000);
+    check(F("begin_UART retried finds a frame at 2500 ms"),
+          ok && elapsed() == 2500);
+  }
+
+  {
+    // ... but in time for a 3 s one, across the wraparound
+    virtualClock.time = CLOCK_START;
+    FakeSerial port(2500);
+    Adafruit_PM25AQI aqi;
+    aqi.setClock(&virtualClock);
+    bool ok = aqi.begin_UART(&port, false, 3000);
+    check(F("begin_UART finds a frame at 2500 ms"), ok && elapsed() == 2500);
+  }
+
+  {
+    virtualClock.time = CLOCK_START;
+    FakeSerial port(0);
+    Adafruit_PM25AQI aqi;
+    PM25_AQI_Data data;
+    aqi.setClock(&virtualClock);
+    aqi.begin_UART(&port);
+    bool ok = aqi.read(&data, 50);
+    check(F("read returns a waiting frame at once"),
+          ok && data.pm25_env == 35 && elapsed() == 0);
+    ok = aqi.read(&data, 50);
+    check(F("read gives up after 50 ms"), !ok && elapsed() == 50);
+  }
+
+  {
+    virtualClock.time = CLOCK_START;
+    FakeSerial port(5000);
+    UARTDevice device(&port);
+    uint8_t buffer[4];
+    device.setClock(&virtualClock);
+    bool ok = UARTDevice::uart_read(&device, buffer, sizeof(buffer));
+    check(F("uart_read gives up after 100 ms"), !ok && elapsed() == 100);
+  }
+
+  Serial.print(failures);
+  Serial.println(F(" failures"));
+}
+
+void loop() {}
@@ -0,0 +1,59 @@
+/* Test sketch for Adafruit PM2.5 sensor that reports sensor health:
+   firmware version and error code, clean air baseline drift, dead or
+   saturated output and an overall health score. */
+
+#include "Adafruit_PM25AQI.h"
+#include "Adafruit_AQIDiagnostics.h"
+
+Adafruit_PM25AQI aqi = Adafruit_PM25AQI();
+Adafruit_AQIDiagnostics diagnostics;
+
+void setup() {
+  // Wait for serial monitor to open
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println("Adafruit PMSA003I Air Quality Sensor - diagnostics");
+
+  // Wait three seconds for sensor to boot up!
+  delay(3000);
+
+  if (! aqi.begin_I2C()) {      // connect to the sensor over I2C
+    Serial.println("Could not find PM 2.5 sensor!");
+    while (1) delay(10);
+  }
+
+  Serial.println("PM25 found!");
+
+  // Frames with PM2.5 at or below 5 ug/m3 feed the clean air baseline
+  diagnostics.setCleanAir(5);
+  // Flag the sensor once the baseline moves 30% from where it started
+  diagnostics.setDriftLimit(30);
+}
+
+void loop() {
+  PM25_AQI_Data data;
+
+  if (! aqi.read(&data)) {
+    delay(500);  // try again in a bit!
+    return;
+  }
+
+  diagnostics.update(&data);
+
+  Serial.print(F("Version: 0x")); Serial.print(diagnostics.version(), HEX);
+  Serial.print(F("\tError: ")); Serial.print(diagnostics.errorCode());
+  Serial.print(F("\tBaseline: ")); Serial.print(diagnostics.baseline());
+  Serial.print(F(" (ref ")); Serial.print(diagnostics.reference());
+  Serial.print(F(", drift ")); Serial.print(diagnostics.drift());
+  Serial.print(F("%)\tHealth: ")); Serial.print(diagnostics.health());
+
+  uint8_t faults = diagnostics.faults();
+  if (faults & PM25AQI_DIAG_ERROR) Serial.print(F(" ERROR"));
+  if (faults & PM25AQI_DIAG_ZERO) Serial.print(F(" ZERO"));
+  if (faults & PM25AQI_DIAG_SATURATED) Serial.print(F(" SATURATED"));
+  if (faults & PM25AQI_DIAG_DRIFT) Serial.print(F(" DRIFT"));
+  Serial.println();
+
+  delay(1000);
+}
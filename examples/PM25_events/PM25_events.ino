@@ -0,0 +1,81 @@
+/* Test sketch for Adafruit PM2.5 sensor that only prints when something
+   changes: AQI category, threshold crossings, spikes or a stuck sensor.
+   Replace the prints in onEvent() with your radio uplink. */
+
+#include "Adafruit_PM25AQI.h"
+#include "Adafruit_AQIEvents.h"
+
+Adafruit_PM25AQI aqi = Adafruit_PM25AQI();
+Adafruit_AQIEvents events;
+
+void onEvent(const aqi_event_t *event, void *context) {
+  switch (event->type) {
+  case AQI_EVENT_CATEGORY:
+    Serial.print(F("AQI category change on scale "));
+    break;
+  case AQI_EVENT_THRESHOLD_RISE:
+    Serial.print(F("Rose above threshold "));
+    break;
+  case AQI_EVENT_THRESHOLD_FALL:
+    Serial.print(F("Fell below threshold "));
+    break;
+  case AQI_EVENT_SPIKE:
+    Serial.print(F("Spike on field "));
+    break;
+  case AQI_EVENT_STUCK:
+    Serial.print(F("Sensor stuck "));
+    break;
+  case AQI_EVENT_UNSTUCK:
+    Serial.print(F("Sensor recovered "));
+    break;
+  }
+  Serial.print(event->source);
+  Serial.print(F(": ")); Serial.print(event->previous);
+  Serial.print(F(" -> ")); Serial.println(event->current);
+}
+
+void setup() {
+  // Wait for serial monitor to open
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println("Adafruit PMSA003I Air Quality Sensor - events");
+
+  // Wait three seconds for sensor to boot up!
+  delay(3000);
+
+  // If using serial, initialize it and set baudrate before starting!
+  // Uncomment one of the following
+  //Serial1.begin(9600);
+
+  if (! aqi.begin_I2C()) {      // connect to the sensor over I2C
+  //if (! aqi.begin_UART(&Serial1)) { // connect to the sensor over hardware serial
+    Serial.println("Could not find PM 2.5 sensor!");
+    while (1) delay(10);
+  }
+
+  Serial.println("PM25 found!");
+
+  events.setCallback(onEvent);
+  // Don't report a lower category until 5 AQI points below its boundary
+  events.setCategoryHysteresis(5);
+  // PM2.5 above 35 ug/m3, re-armed once it drops below 30
+  events.setThreshold(0, AQI_FIELD_PM25_ENV, 35, 5);
+  // PM2.5 jumping by more than 25 ug/m3 from one reading to the next
+  events.setSpike(AQI_FIELD_PM25_ENV, 25);
+  // 60 identical readings in a row
+  events.setStuckFrames(60);
+}
+
+void loop() {
+  PM25_AQI_Data data;
+
+  if (! aqi.read(&data)) {
+    delay(500);  // try again in a bit!
+    return;
+  }
+
+  events.update(&data);
+
+  delay(1000);
+}
@@ -0,0 +1,66 @@
+/* Test sketch for three redundant PM2.5 sensors at one site, combined into
+   one consensus reading. A sensor that disagrees with the other two is left
+   out and its trust score drops.
+
+   Wiring here (ESP32): one PMSA003I on I2C, two PM2.5 UART sensors on
+   Serial1 and Serial2. */
+
+#include "Adafruit_PM25AQI.h"
+#include "Adafruit_AQIFusion.h"
+
+Adafruit_PM25AQI aqi0 = Adafruit_PM25AQI();
+Adafruit_PM25AQI aqi1 = Adafruit_PM25AQI();
+Adafruit_PM25AQI aqi2 = Adafruit_PM25AQI();
+Adafruit_PM25AQI *sensors[] = {&aqi0, &aqi1, &aqi2};
+
+Adafruit_AQIFusion fusion(sensors, 3);
+
+void setup() {
+  // Wait for serial monitor to open
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println("Adafruit PM2.5 sensor fusion");
+
+  // Wait three seconds for sensors to boot up!
+  delay(3000);
+
+  Serial1.begin(9600);
+  Serial2.begin(9600);
+
+  if (! aqi0.begin_I2C() || ! aqi1.begin_UART(&Serial1) ||
+      ! aqi2.begin_UART(&Serial2)) {
+    Serial.println("Could not find all PM 2.5 sensors!");
+    while (1) delay(10);
+  }
+
+  Serial.println("PM25 sensors found!");
+
+  // Sensors report about once a second, use readings up to 3 seconds old
+  fusion.setMaxAge(3000);
+  // Flag a sensor more than 5 ug/m3 or 25% away from the others
+  fusion.setOutlierLimit(5, 25);
+}
+
+void loop() {
+  PM25_AQI_Data data;
+
+  fusion.poll();
+
+  if (fusion.fuse(&data)) {
+    Serial.print(F("PM 2.5: ")); Serial.print(data.pm25_env);
+    Serial.print(F("\tAQI US: ")); Serial.print(data.aqi_pm25_us);
+    Serial.print(F("\tfrom ")); Serial.print(fusion.used());
+    Serial.print(F(" sensors, trust:"));
+    for (uint8_t i = 0; i < 3; i++) {
+      Serial.print(' '); Serial.print(fusion.trust(i));
+      if (fusion.isOutlier(i)) Serial.print('!');
+    }
+    Serial.println();
+  } else {
+    // no recent frames, or every sensor was left out
+    Serial.println(F("No consensus"));
+  }
+
+  delay(1000);
+}
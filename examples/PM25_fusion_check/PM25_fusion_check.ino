@@ -0,0 +1,90 @@
+/* Checks how Adafruit_AQIFusion settles a disagreement between two
+   sensors, without any sensors attached.
+
+   Frames go in through update() with made up timestamps. Both sensors
+   start with the same trust score and agree for a while, then one of them
+   jumps from 10 to 80 ug/m3 and stays there. The fusion must keep
+   returning the sensor that stayed put, and the scores must split so the
+   disagreement stays settled after the jump. */
+
+#include "Adafruit_AQIFusion.h"
+
+uint8_t failures = 0;
+
+void check(const __FlashStringHelper *name, bool passed) {
+  Serial.print(passed ? F("PASS ") : F("FAIL "));
+  Serial.println(name);
+  if (!passed) failures++;
+}
+
+// Feeds both sensors for a while, sensor jumper moving to 80 at frame 3.
+// Returns true if every fuse() from the jump on gave 10 from one sensor.
+bool runJump(Adafruit_AQIFusion &fusion, uint8_t jumper) {
+  bool settled = true;
+  for (uint32_t t = 0; t < 10; t++) {
+    PM25_AQI_Data frame = {};
+    for (uint8_t i = 0; i < 2; i++) {
+      bool jumped = (i == jumper) && t >= 3;
+      frame.pm25_env = jumped ? 80 : 10;
+      frame.pm100_env = jumped ? 90 : 12;
+      fusion.update(i, &frame, t * 1000);
+    }
+
+    PM25_AQI_Data data;
+    bool ok = fusion.fuse(&data, t * 1000 + 500);
+    if (t >= 3) {
+      settled = settled && ok && data.pm25_env == 10 && fusion.used() == 1 &&
+                fusion.isOutlier(jumper) && !fusion.isOutlier(1 - jumper);
+    }
+  }
+  return settled;
+}
+
+void setup() {
+  // Wait for serial monitor to open
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println("PM25 AQI fusion check");
+
+  {
+    Adafruit_AQIFusion fusion(nullptr, 2);
+    check(F("second sensor jumps, first is kept"), runJump(fusion, 1));
+    check(F("trust scores split"), fusion.trust(0) > fusion.trust(1));
+  }
+
+  {
+    Adafruit_AQIFusion fusion(nullptr, 2);
+    check(F("first sensor jumps, second is kept"), runJump(fusion, 0));
+    check(F("trust scores split"), fusion.trust(1) > fusion.trust(0));
+  }
+
+  {
+    // Disagreeing from the first frame, so nothing tells them apart
+    Adafruit_AQIFusion fusion(nullptr, 2);
+    PM25_AQI_Data frame = {}, data;
+    frame.pm25_env = 10;
+    fusion.update(0, &frame, 0);
+    frame.pm25_env = 80;
+    fusion.update(1, &frame, 0);
+    bool ok = fusion.fuse(&data, 0);
+    check(F("no history, first sensor is the primary"),
+          ok && data.pm25_env == 10 && fusion.isOutlier(1));
+  }
+
+  {
+    // The consensus gets its AQI from the library, not from a sensor
+    Adafruit_AQIFusion fusion(nullptr, 1);
+    PM25_AQI_Data frame = {}, data;
+    frame.pm25_env = 35;
+    fusion.update(0, &frame, 0);
+    bool ok = fusion.fuse(&data, 0);
+    check(F("AQI is recomputed without sensors"),
+          ok && data.aqi_pm25_us == 99);
+  }
+
+  Serial.print(failures);
+  Serial.println(F(" failures"));
+}
+
+void loop() {}
@@ -0,0 +1,69 @@
+/* Test sketch for Adafruit PM2.5 sensor shared between FreeRTOS tasks
+   (ESP32). One task owns the sensor and publishes each good reading, a
+   display task and a logger task read the latest one without locking and
+   without touching I2C/UART. */
+
+#include "Adafruit_PM25AQI.h"
+#include "Adafruit_AQISharedData.h"
+
+Adafruit_PM25AQI aqi = Adafruit_PM25AQI();
+Adafruit_AQISharedData shared(&aqi);
+
+// The only task that talks to the sensor
+void acquireTask(void *param) {
+  for (;;) {
+    shared.acquire();
+    vTaskDelay(pdMS_TO_TICKS(1000));
+  }
+}
+
+// Stand-in for a display refresh
+void displayTask(void *param) {
+  PM25_AQI_Data data;
+  for (;;) {
+    if (shared.latest(&data)) {
+      Serial.print(F("[display] PM 2.5: ")); Serial.println(data.pm25_env);
+    }
+    vTaskDelay(pdMS_TO_TICKS(2000));
+  }
+}
+
+// Stand-in for a logger, only logs new frames
+void loggerTask(void *param) {
+  PM25_AQI_Data data;
+  aqi_seq_t last = 0, seq;
+  for (;;) {
+    if (shared.sequence() != last && shared.latest(&data, &seq)) {
+      last = seq;
+      Serial.print(F("[logger] frame ")); Serial.print(seq / 2);
+      Serial.print(F(" AQI US: ")); Serial.println(data.aqi_pm25_us);
+    }
+    vTaskDelay(pdMS_TO_TICKS(500));
+  }
+}
+
+void setup() {
+  // Wait for serial monitor to open
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println("Adafruit PMSA003I Air Quality Sensor - shared between tasks");
+
+  // Wait three seconds for sensor to boot up!
+  delay(3000);
+
+  if (! aqi.begin_I2C()) {      // connect to the sensor over I2C
+    Serial.println("Could not find PM 2.5 sensor!");
+    while (1) delay(10);
+  }
+
+  Serial.println("PM25 found!");
+
+  xTaskCreate(acquireTask, "acquire", 4096, NULL, 2, NULL);
+  xTaskCreate(displayTask, "display", 4096, NULL, 1, NULL);
+  xTaskCreate(loggerTask, "logger", 4096, NULL, 1, NULL);
+}
+
+void loop() {
+  vTaskDelay(pdMS_TO_TICKS(1000));
+}
@@ -0,0 +1,78 @@
+/* Test sketch for Adafruit PM2.5 sensor that packs each reading into a
+   small payload for a LoRa (or other low bandwidth) uplink, decodes it again
+   the way the receiving end would, and prints the compression ratio. */
+
+#include "Adafruit_PM25AQI.h"
+#include "Adafruit_AQITelemetry.h"
+
+Adafruit_PM25AQI aqi = Adafruit_PM25AQI();
+
+// Both ends must use the same field setup
+Adafruit_AQITelemetry encoder;
+Adafruit_AQITelemetry decoder;
+
+uint32_t frames = 0, bytes_sent = 0;
+
+void setupFields(Adafruit_AQITelemetry &packer) {
+  // pm10_env, pm25_env and pm100_env are sent by default. Also send the
+  // 0.3um particle count, dropping 3 bits (steps of 8 particles)
+  packer.setField(AQI_PACK_PARTICLES_03UM, 3, 6);
+  // keyframe at least every 30 packets
+  packer.setKeyframeInterval(30);
+}
+
+void setup() {
+  // Wait for serial monitor to open
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+
+  Serial.println("Adafruit PMSA003I Air Quality Sensor - telemetry");
+
+  // Wait three seconds for sensor to boot up!
+  delay(3000);
+
+  if (! aqi.begin_I2C()) {      // connect to the sensor over I2C
+    Serial.println("Could not find PM 2.5 sensor!");
+    while (1) delay(10);
+  }
+
+  Serial.println("PM25 found!");
+
+  setupFields(encoder);
+  setupFields(decoder);
+  Serial.print(F("Keyframe: ")); Serial.print(encoder.keyframeSize());
+  Serial.print(F(" bytes, delta: ")); Serial.print(encoder.deltaSize());
+  Serial.println(F(" bytes"));
+}
+
+void loop() {
+  PM25_AQI_Data data, received;
+  uint8_t payload[PM25AQI_TELEMETRY_MAX_PAYLOAD];
+
+  if (! aqi.read(&data)) {
+    delay(500);  // try again in a bit!
+    return;
+  }
+
+  size_t len = encoder.encode(&data, payload, sizeof(payload));
+  frames++;
+  bytes_sent += len;
+
+  // This is where the payload would go out over the radio
+  Serial.print(F("Payload:"));
+  for (size_t i = 0; i < len; i++) {
+    Serial.print(' ');
+    if (payload[i] < 0x10) Serial.print('0');
+    Serial.print(payload[i], HEX);
+  }
+
+  if (decoder.decode(payload, len, &received)) {
+    Serial.print(F("\tPM 2.5: ")); Serial.print(received.pm25_env);
+    Serial.print(F("\t>0.3um: ")); Serial.print(received.particles_03um);
+  }
+  Serial.print(F("\tRatio: "));
+  Serial.print((float)(frames * sizeof(PM25_AQI_Data)) / bytes_sent);
+  Serial.println('x');
+
+  delay(1000);
+}
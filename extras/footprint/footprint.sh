@@ -0,0 +1,207 @@
+#!/usr/bin/env bash
+#
+# Builds extras/footprint/footprint for a few configurations with
+# arduino-cli and reports what the library costs on an AVR board: static
+# RAM, whether anything is heap allocated, the deepest stack below the
+# sketch and flash per feature. Exits non-zero if the minimal UART
+# configuration is over the budget documented in README.md.
+#
+#   extras/footprint/footprint.sh [fqbn]
+#
+# Needs arduino-cli with the board's core and Adafruit BusIO installed.
+#
+# Adafruit invests time and resources providing this open source code,
+# please support Adafruit and open-source hardware by purchasing
+# products from Adafruit!
+#
+# BSD license, all text here must be included in any redistribution.
+
+set -euo pipefail
+
+FQBN=${1:-arduino:avr:uno}
+
+# Budget for the minimal UART-only configuration, Adafruit_PM25AQI_UARTReader
+# on Serial (library cost over the baseline sketch), see README.md
+BUDGET_RAM=128   # bytes of static RAM
+BUDGET_STACK=96  # bytes of stack below the caller of read()
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+LIBRARY=$(cd "$HERE/../.." && pwd)
+SKETCH="$HERE/footprint"
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# name|flags, the first entry is what the others are measured against
+CONFIGS=(
+  "baseline|"
+  "uart|-DFOOTPRINT_UART"
+  "uart+lut|-DFOOTPRINT_UART -DPM25AQI_USE_AQI_LUT"
+  "uart+events|-DFOOTPRINT_UART -DFOOTPRINT_EVENTS"
+  "uart+telemetry|-DFOOTPRINT_UART -DFOOTPRINT_TELEMETRY"
+  "uart+diagnostics|-DFOOTPRINT_UART -DFOOTPRINT_DIAGNOSTICS"
+  "uart+shared|-DFOOTPRINT_UART -DFOOTPRINT_SHARED"
+  "uart+fusion|-DFOOTPRINT_UART -DFOOTPRINT_FUSION"
+  "uart_driver|-DFOOTPRINT_UART_DRIVER"
+  "begin_UART|-DFOOTPRINT_WRAPPER_UART"
+  "begin_I2C|-DFOOTPRINT_WRAPPER_I2C"
+)
+
+# Call chains from the library functions the sketch calls, the deepest one
+# linked into a build is its peak. Each is a list of function names as they
+# appear in the .su files, where file-static helpers have no class prefix.
+# A chain only counts if its first function is in the linked sketch; every
+# library source is compiled, so the .su files can't tell.
+CONVERT="Adafruit_AQIUtils::ConvertAQIData"
+WRAPPER_CONVERT="Adafruit_PM25AQI::ConvertAQIData $CONVERT"
+UART_CHAINS=(
+  "Adafruit_PM25AQI_Parser::push Adafruit_PM25AQI_Parser::scan Adafruit_PM25AQI_Parser::dropToNextStart"
+  "Adafruit_PM25AQI_Parser::push Adafruit_PM25AQI_Parser::scan Adafruit_PM25AQI_Parser::valid"
+  "Adafruit_PM25AQI_Parser::decode Adafruit_PM25AQI_Parser::decodePM25"
+  "$CONVERT Adafruit_AQIUtils::pm100_aqi_us Adafruit_AQIUtils::MapLinear"
+  "$CONVERT Adafruit_AQIUtils::pm25_aqi_us Adafruit_AQIUtils::MapLinear"
+  "$CONVERT Adafruit_AQIUtils::pm25_aqi_us_lut lookup_aqi"
+)
+CHAINS=(
+  "Adafruit_PM25AQI_I2C::read Adafruit_I2CDevice::read Adafruit_I2CDevice::_read TwoWire::requestFrom"
+  "Adafruit_PM25AQI_I2C::read Adafruit_PM25AQI_Parser::valid"
+  "Adafruit_PM25AQI_I2C::read $WRAPPER_CONVERT Adafruit_AQIUtils::pm25_aqi_us Adafruit_AQIUtils::MapLinear"
+  "Adafruit_AQIEvents::update Adafruit_AQIEvents::raise"
+  "Adafruit_AQITelemetry::encode put_bits"
+  "Adafruit_AQITelemetry::encode Adafruit_AQITelemetry::keyframeSize"
+  "Adafruit_AQIDiagnostics::update Adafruit_AQIDiagnostics::versionOf"
+  "Adafruit_AQIDiagnostics::health Adafruit_AQIDiagnostics::faults Adafruit_AQIDiagnostics::drift"
+  "Adafruit_AQISharedData::publish"
+  "Adafruit_AQISharedData::latest"
+  "Adafruit_AQIFusion::fuse Adafruit_AQIFusion::median"
+  "Adafruit_AQIFusion::fuse Adafruit_AQIFusion::outlierLimit"
+  "Adafruit_AQIFusion::fuse $CONVERT Adafruit_AQIUtils::pm100_aqi_us Adafruit_AQIUtils::MapLinear"
+)
+for chain in "${UART_CHAINS[@]}"; do
+  CHAINS+=("Adafruit_PM25AQI_UARTReader::read $chain")
+done
+# the UART driver reads through a reader, the wrapper's read() calls down
+# into either driver
+for chain in "${CHAINS[@]}"; do
+  case $chain in
+  Adafruit_PM25AQI_UARTReader::read*)
+    CHAINS+=("Adafruit_PM25AQI_UART::read $chain")
+    CHAINS+=("Adafruit_PM25AQI::read Adafruit_PM25AQI_UART::read $chain")
+    ;;
+  Adafruit_PM25AQI_I2C::read*)
+    CHAINS+=("Adafruit_PM25AQI::read $chain")
+    ;;
+  esac
+done
+
+tool() {
+  local found
+  found=$(command -v "$1" || true)
+  if [ -z "$found" ]; then
+    found=$(ls -d "$HOME"/.arduino15/packages/*/tools/avr-gcc/*/bin/"$1" \
+      2>/dev/null | tail -n 1)
+  fi
+  if [ -z "$found" ]; then
+    echo "can't find $1, put the AVR toolchain on PATH" >&2
+    exit 1
+  fi
+  echo "$found"
+}
+
+# section size from avr-size -A
+section() {
+  awk -v s="$2" '$1 == s { print $2; found = 1 } END { if (!found) print 0 }' \
+    <<<"$1"
+}
+
+# stack frame of a function from the .su files, 0 if inlined away
+frame() {
+  find "$1" -name '*.su' -exec cat {} + 2>/dev/null |
+    awk -F'\t' -v f="$2" 'index($1, f "(") { if ($2 > m) m = $2 }
+                          END { print m + 0 }'
+}
+
+# deepest call chain linked into a build, in bytes
+peak_stack() {
+  local build=$1 symbols peak=0 chain fn total
+  symbols=$("$NM" -C "$build/footprint.ino.elf")
+  for chain in "${CHAINS[@]}"; do
+    if ! grep -qF "${chain%% *}(" <<<"$symbols"; then
+      continue
+    fi
+    total=0
+    for fn in $chain; do
+      # plus a 2 byte return address per call, which overcounts a little
+      # when a function was inlined
+      total=$((total + $(frame "$build" "$fn") + 2))
+    done
+    if [ "$total" -gt "$peak" ]; then
+      peak=$total
+    fi
+  done
+  echo "$peak"
+}
+
+build() {
+  local name=$1 flags=$2 out="$WORK/$1"
+  arduino-cli compile --fqbn "$FQBN" --library "$LIBRARY" \
+    --build-path "$out" \
+    --build-property "compiler.cpp.extra_flags=$flags -fstack-usage" \
+    --build-property "compiler.c.extra_flags=$flags" \
+    "$SKETCH" >"$WORK/$name.log" 2>&1 || {
+    cat "$WORK/$name.log" >&2
+    exit 1
+  }
+}
+
+SIZE=$(tool avr-size)
+NM=$(tool avr-nm)
+
+printf "%-18s %8s %8s %10s %8s %6s\n" config flash ram "ram+lib" heap stack
+base_flash=0
+base_ram=0
+over=0
+for config in "${CONFIGS[@]}"; do
+  name=${config%%|*}
+  flags=${config#*|}
+  build "$name" "$flags"
+  elf="$WORK/$name/footprint.ino.elf"
+
+  sizes=$("$SIZE" -A "$elf")
+  data=$(section "$sizes" .data)
+  bss=$(section "$sizes" .bss)
+  text=$(section "$sizes" .text)
+  flash=$((text + data))
+  ram=$((data + bss))
+  # operator new and delete too, a host libc keeps malloc in a shared object.
+  # nm's output is kept first, grep -q exiting early would fail the pipe.
+  symbols=$("$NM" "$elf")
+  heap=none
+  if grep -qE ' (malloc|free|_Znw|_Zdl)' <<<"$symbols"; then
+    heap=malloc
+  fi
+  stack=$(peak_stack "$WORK/$name")
+  if [ "$name" = baseline ]; then
+    base_flash=$flash
+    base_ram=$ram
+  fi
+  printf "%-18s %+8d %+8d %10d %8s %6d\n" "$name" $((flash - base_flash)) \
+    $((ram - base_ram)) "$ram" "$heap" "$stack"
+
+  if [ "$name" = uart ]; then
+    lib_ram=$((ram - base_ram))
+    lib_heap=$heap
+    lib_stack=$stack
+  fi
+done
+
+echo
+echo "minimal UART config: $lib_ram bytes RAM (budget $BUDGET_RAM)," \
+  "heap $lib_heap (budget none), stack $lib_stack bytes" \
+  "(budget $BUDGET_STACK)"
+if [ "$lib_ram" -gt "$BUDGET_RAM" ]; then over=1; fi
+if [ "$lib_heap" != none ]; then over=1; fi
+if [ "$lib_stack" -gt "$BUDGET_STACK" ]; then over=1; fi
+if [ "$over" -ne 0 ]; then
+  echo "OVER BUDGET" >&2
+  exit 1
+fi
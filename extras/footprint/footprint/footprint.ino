@@ -0,0 +1,83 @@
+/* Sketch used by footprint.sh to measure the library's RAM and flash.
+   The configuration is picked with -D flags, see footprint.sh. With no
+   flags it is the baseline: the same Serial use without the library. */
+
+#if defined(FOOTPRINT_UART)
+#include "Adafruit_PM25AQI_UARTReader.h"
+Adafruit_PM25AQI_UARTReader aqi;
+#elif defined(FOOTPRINT_UART_DRIVER)
+#include "Adafruit_PM25AQI_UART.h"
+Adafruit_PM25AQI_UART aqi;
+#elif defined(FOOTPRINT_WRAPPER_UART) || defined(FOOTPRINT_WRAPPER_I2C)
+#include "Adafruit_PM25AQI.h"
+Adafruit_PM25AQI aqi;
+#endif
+
+#ifdef FOOTPRINT_EVENTS
+#include "Adafruit_AQIEvents.h"
+Adafruit_AQIEvents events;
+#endif
+#ifdef FOOTPRINT_TELEMETRY
+#include "Adafruit_AQITelemetry.h"
+Adafruit_AQITelemetry telemetry;
+#endif
+#ifdef FOOTPRINT_DIAGNOSTICS
+#include "Adafruit_AQIDiagnostics.h"
+Adafruit_AQIDiagnostics diagnostics;
+#endif
+#ifdef FOOTPRINT_SHARED
+#include "Adafruit_AQISharedData.h"
+Adafruit_AQISharedData shared;
+#endif
+#ifdef FOOTPRINT_FUSION
+#include "Adafruit_AQIFusion.h"
+Adafruit_AQIFusion fusion(nullptr, 1); // fed through update()
+#endif
+
+void setup() {
+  Serial.begin(9600);
+#if defined(FOOTPRINT_UART) || defined(FOOTPRINT_UART_DRIVER)
+  aqi.begin(&Serial);
+#elif defined(FOOTPRINT_WRAPPER_UART)
+  aqi.begin_UART(&Serial);
+#elif defined(FOOTPRINT_WRAPPER_I2C)
+  aqi.begin_I2C();
+#endif
+}
+
+void loop() {
+#if defined(FOOTPRINT_UART) || defined(FOOTPRINT_UART_DRIVER) ||             \
+    defined(FOOTPRINT_WRAPPER_UART) || defined(FOOTPRINT_WRAPPER_I2C)
+  PM25_AQI_Data data;
+  if (!aqi.read(&data)) {
+    return;
+  }
+#ifdef FOOTPRINT_EVENTS
+  events.update(&data);
+#endif
+#ifdef FOOTPRINT_TELEMETRY
+  uint8_t payload[PM25AQI_TELEMETRY_MAX_PAYLOAD];
+  Serial.write(payload, telemetry.encode(&data, payload, sizeof(payload)));
+#endif
+#ifdef FOOTPRINT_DIAGNOSTICS
+  diagnostics.update(&data);
+  Serial.write(diagnostics.health());
+#endif
+#ifdef FOOTPRINT_SHARED
+  shared.publish(&data);
+  shared.latest(&data);
+#endif
+#ifdef FOOTPRINT_FUSION
+  fusion.update(0, &data, millis());
+  fusion.fuse(&data);
+#endif
+  Serial.println(data.pm25_env);
+  Serial.println(data.aqi_pm25_us);
+#else
+  int c = Serial.read();
+  if (c >= 0) {
+    Serial.println(c);
+    Serial.println(c);
+  }
+#endif
+}
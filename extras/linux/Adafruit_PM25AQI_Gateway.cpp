@@ -0,0 +1,424 @@
+/*!
+ * @file Adafruit_PM25AQI_Gateway.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_PM25AQI_Gateway.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+
+/*!
+ *  @brief  Instantiates a new gateway with no streams
+ */
+Adafruit_PM25AQI_Gateway::Adafruit_PM25AQI_Gateway() {
+  for (uint8_t i = 0; i < PM25AQI_GATEWAY_MAX_STREAMS; i++) {
+    _streams[i].path[0] = '\0';
+  }
+}
+
+/*!
+ *  @brief  Closes every stream opened by path and the epoll instance
+ */
+Adafruit_PM25AQI_Gateway::~Adafruit_PM25AQI_Gateway() {
+  for (uint8_t i = 0; i < PM25AQI_GATEWAY_MAX_STREAMS; i++) {
+    close(i);
+  }
+  if (_epoll_fd >= 0) {
+    ::close(_epoll_fd);
+    _epoll_fd = -1;
+  }
+}
+
+/*!
+ *  @brief  Creates the epoll instance
+ *  @return True on success, false if epoll isn't available
+ */
+bool Adafruit_PM25AQI_Gateway::begin() {
+  if (_epoll_fd < 0) {
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  }
+  return _epoll_fd >= 0;
+}
+
+/*!
+ *  @brief  Opens a serial device in raw 8N1 mode and starts reading it
+ *  @param  path
+ *          Device, e.g. /dev/ttyUSB0, or the slave side of a pty
+ *  @param  is_pm1006
+ *          True for a Cubic PM1006, false for a Plantower sensor
+ *  @param  baud
+ *          termios speed, both sensors use B9600
+ *  @return Stream index, or -1 if the device can't be opened or all
+ *          PM25AQI_GATEWAY_MAX_STREAMS are in use
+ */
+int Adafruit_PM25AQI_Gateway::open(const char *path, bool is_pm1006,
+                                   speed_t baud) {
+  int stream = reserve(path, is_pm1006, baud);
+  if (stream < 0) {
+    return -1;
+  }
+  if (!reopen(stream)) {
+    _streams[stream].used = false;
+    _streams[stream].path[0] = '\0';
+    return -1;
+  }
+  return stream;
+}
+
+/*!
+ *  @brief  Reserves a stream for a serial device without opening it, for a
+ *          device that may not be plugged in yet. reopen() opens it.
+ *  @param  path
+ *          Device, e.g. /dev/ttyUSB0, or the slave side of a pty
+ *  @param  is_pm1006
+ *          True for a Cubic PM1006, false for a Plantower sensor
+ *  @param  baud
+ *          termios speed, both sensors use B9600
+ *  @return Stream index, or -1 if the path is too long or all
+ *          PM25AQI_GATEWAY_MAX_STREAMS are in use
+ */
+int Adafruit_PM25AQI_Gateway::reserve(const char *path, bool is_pm1006,
+                                      speed_t baud) {
+  if (!path || strlen(path) >= PM25AQI_GATEWAY_MAX_PATH) {
+    return -1;
+  }
+  for (uint8_t i = 0; i < PM25AQI_GATEWAY_MAX_STREAMS; i++) {
+    Stream &s = _streams[i];
+    if (!s.used) {
+      s.used = true;
+      s.baud = baud;
+      s.parser = Adafruit_PM25AQI_Parser(is_pm1006);
+      s.frames = 0;
+      strcpy(s.path, path);
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*!
+ *  @brief  Starts reading a descriptor the caller already opened and set
+ *          up, such as a socket or a pipe. It is made non-blocking and is
+ *          not closed by the gateway. Its index is freed when the stream is
+ *          closed or hangs up.
+ *  @param  fd
+ *          Descriptor to read
+ *  @param  is_pm1006
+ *          True for a Cubic PM1006, false for a Plantower sensor
+ *  @return Stream index, or -1 if all PM25AQI_GATEWAY_MAX_STREAMS are in use
+ */
+int Adafruit_PM25AQI_Gateway::attach(int fd, bool is_pm1006) {
+  if (fd < 0) {
+    return -1;
+  }
+  int flags = fcntl(fd, F_GETFL);
+  if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    return -1;
+  }
+  return add(fd, false, is_pm1006, -1);
+}
+
+/*!
+ *  @brief  Opens a stream's device again after it was closed, for example
+ *          when a USB adapter is plugged back in, or for the first time
+ *          after reserve(). The stream keeps its index and frame counts.
+ *  @param  stream
+ *          Index of a stream created by open() or reserve()
+ *  @return True if the stream is open
+ */
+bool Adafruit_PM25AQI_Gateway::reopen(uint8_t stream) {
+  if (stream >= PM25AQI_GATEWAY_MAX_STREAMS || !_streams[stream].used ||
+      _streams[stream].path[0] == '\0') {
+    return false;
+  }
+  if (_streams[stream].fd >= 0) {
+    return true;
+  }
+  int fd = openSerial(_streams[stream].path, _streams[stream].baud);
+  if (fd < 0) {
+    return false;
+  }
+  if (add(fd, true, _streams[stream].parser.frameLength() == PM1006_FRAME_LEN,
+          stream) < 0) {
+    ::close(fd);
+    return false;
+  }
+  return true;
+}
+
+/*!
+ *  @brief  Stops reading a stream, closing its device if open() opened it.
+ *          A stream with a path keeps its index for reopen(). An attach()ed
+ *          one can't be reopened, so its index is freed for reuse.
+ *  @param  stream
+ *          Index of the stream
+ */
+void Adafruit_PM25AQI_Gateway::close(uint8_t stream) {
+  if (stream >= PM25AQI_GATEWAY_MAX_STREAMS || _streams[stream].fd < 0) {
+    return;
+  }
+  Stream &s = _streams[stream];
+  if (_epoll_fd >= 0) {
+    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, s.fd, nullptr);
+  }
+  if (s.owned) {
+    ::close(s.fd);
+  }
+  s.fd = -1;
+  if (s.path[0] == '\0') {
+    s.used = false;
+  }
+}
+
+/*!
+ *  @brief  Sets the function called for every decoded frame
+ *  @param  callback
+ *          Function to call, or nullptr to only count frames
+ *  @param  context
+ *          Passed back to the callback unchanged
+ */
+void Adafruit_PM25AQI_Gateway::setCallback(pm25aqi_reading_callback_t callback,
+                                           void *context) {
+  _callback = callback;
+  _context = context;
+}
+
+/*!
+ *  @brief  Waits for data on any stream and decodes everything available
+ *  @param  timeout_ms
+ *          Longest wait in milliseconds, -1 to wait forever, 0 to not wait
+ *  @return Number of frames decoded, or -1 if interrupted by a signal or
+ *          begin() wasn't called
+ */
+int Adafruit_PM25AQI_Gateway::poll(int timeout_ms) {
+  struct epoll_event events[PM25AQI_GATEWAY_MAX_STREAMS];
+
+  if (_epoll_fd < 0) {
+    return -1;
+  }
+  int ready =
+      epoll_wait(_epoll_fd, events, PM25AQI_GATEWAY_MAX_STREAMS, timeout_ms);
+  if (ready < 0) {
+    return -1;
+  }
+
+  int count = 0;
+  for (int e = 0; e < ready; e++) {
+    uint8_t stream = events[e].data.u32;
+    uint32_t before = _streams[stream].frames;
+    // hang ups still drain first, a pty can hold data after its writer left
+    if (!drain(stream) ||
+        (events[e].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR))) {
+      close(stream);
+    }
+    count += _streams[stream].frames - before;
+  }
+  return count;
+}
+
+/*!
+ *  @brief  Checks if a stream is being read
+ *  @param  stream
+ *          Index of the stream
+ *  @return True if open
+ */
+bool Adafruit_PM25AQI_Gateway::isOpen(uint8_t stream) {
+  return stream < PM25AQI_GATEWAY_MAX_STREAMS && _streams[stream].fd >= 0;
+}
+
+/*!
+ *  @brief  Gets the device a stream was opened from
+ *  @param  stream
+ *          Index of the stream
+ *  @return Path given to open(), empty for attach()ed streams
+ */
+const char *Adafruit_PM25AQI_Gateway::path(uint8_t stream) {
+  if (stream >= PM25AQI_GATEWAY_MAX_STREAMS) {
+    return "";
+  }
+  return _streams[stream].path;
+}
+
+/*!
+ *  @brief  Gets the number of frames decoded from a stream
+ *  @param  stream
+ *          Index of the stream
+ *  @return Frames since the stream was created
+ */
+uint32_t Adafruit_PM25AQI_Gateway::frames(uint8_t stream) {
+  if (stream >= PM25AQI_GATEWAY_MAX_STREAMS) {
+    return 0;
+  }
+  return _streams[stream].frames;
+}
+
+/*!
+ *  @brief  Gets the number of bytes thrown away while resynchronizing
+ *  @param  stream
+ *          Index of the stream
+ *  @return Bytes since the stream was created
+ */
+uint32_t Adafruit_PM25AQI_Gateway::discarded(uint8_t stream) {
+  if (stream >= PM25AQI_GATEWAY_MAX_STREAMS) {
+    return 0;
+  }
+  return _streams[stream].parser.discarded();
+}
+
+/*!
+ *  @brief  Gets the number of frames that failed their checksum
+ *  @param  stream
+ *          Index of the stream
+ *  @return Bad frames since the stream was created
+ */
+uint32_t Adafruit_PM25AQI_Gateway::badChecksums(uint8_t stream) {
+  if (stream >= PM25AQI_GATEWAY_MAX_STREAMS) {
+    return 0;
+  }
+  return _streams[stream].parser.badChecksums();
+}
+
+/*!
+ *  @brief  Puts a descriptor in a stream slot and registers it with epoll
+ *  @param  fd
+ *          Non-blocking descriptor
+ *  @param  owned
+ *          True if close() should close the descriptor
+ *  @param  is_pm1006
+ *          Frame format to parse
+ *  @param  slot
+ *          Slot to reuse, or -1 for the first free one
+ *  @return Stream index, or -1 on failure
+ */
+int Adafruit_PM25AQI_Gateway::add(int fd, bool owned, bool is_pm1006,
+                                  int slot) {
+  if (!begin()) {
+    return -1;
+  }
+  if (slot < 0) {
+    for (uint8_t i = 0; i < PM25AQI_GATEWAY_MAX_STREAMS; i++) {
+      if (!_streams[i].used) {
+        slot = i;
+        break;
+      }
+    }
+    if (slot < 0) {
+      return -1;
+    }
+    _streams[slot].parser = Adafruit_PM25AQI_Parser(is_pm1006);
+    _streams[slot].frames = 0;
+    _streams[slot].path[0] = '\0';
+  }
+
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN | EPOLLRDHUP;
+  event.data.u32 = slot;
+  if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+    return -1;
+  }
+
+  Stream &s = _streams[slot];
+  s.fd = fd;
+  s.owned = owned;
+  s.used = true;
+  s.parser.reset();
+  return slot;
+}
+
+/*!
+ *  @brief  Reads everything waiting on a stream and decodes the frames
+ *  @param  stream
+ *          Index of the stream
+ *  @return False if the stream hung up or failed and should be closed
+ */
+bool Adafruit_PM25AQI_Gateway::drain(uint8_t stream) {
+  uint8_t buffer[PM25AQI_GATEWAY_READ_SIZE];
+  pm25aqi_reading_t reading;
+  Stream &s = _streams[stream];
+
+  reading.stream = stream;
+  while (true) {
+    ssize_t len = read(s.fd, buffer, sizeof(buffer));
+    if (len == 0) {
+      // a tty with nothing left, or end of file on a pipe or socket, which
+      // poll() sees as a hang up
+      return true;
+    }
+    if (len < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // EIO is how a tty reports its adapter going away
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+
+    // one timestamp per read, the bytes arrived within a few ms of each
+    // other at 9600 baud
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    reading.timestamp = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+
+    for (ssize_t i = 0; i < len; i++) {
+      if (!s.parser.push(buffer[i])) {
+        continue;
+      }
+      // a PM1006 frame only fills pm25_env, keep the rest zero
+      memset(&reading.data, 0, sizeof(reading.data));
+      if (s.parser.decode(&reading.data)) {
+        _aqi_utils.ConvertAQIData(&reading.data);
+        s.frames++;
+        if (_callback) {
+          _callback(&reading, _context);
+        }
+      }
+    }
+    if (len < (ssize_t)sizeof(buffer)) {
+      return true; // drained, skip the read that would only say EAGAIN
+    }
+  }
+}
+
+/*!
+ *  @brief  Opens a tty non-blocking in raw 8N1 mode
+ *  @param  path
+ *          Device to open
+ *  @param  baud
+ *          termios speed
+ *  @return Descriptor, or -1 on failure
+ */
+int Adafruit_PM25AQI_Gateway::openSerial(const char *path, speed_t baud) {
+  int fd = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    return -1;
+  }
+
+  struct termios tio;
+  if (tcgetattr(fd, &tio) < 0) {
+    ::close(fd);
+    return -1;
+  }
+  cfmakeraw(&tio);
+  tio.c_cflag |= CLOCAL | CREAD;
+  tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+  tio.c_cc[VMIN] = 1; // with O_NONBLOCK, an empty read gives EAGAIN
+  tio.c_cc[VTIME] = 0;
+  cfsetispeed(&tio, baud);
+  cfsetospeed(&tio, baud);
+  if (tcsetattr(fd, TCSANOW, &tio) < 0) {
+    ::close(fd);
+    return -1;
+  }
+  tcflush(fd, TCIFLUSH); // drop whatever queued up before we were listening
+  return fd;
+}
@@ -0,0 +1,98 @@
+/*!
+ * @file Adafruit_PM25AQI_Gateway.h
+ *
+ * Linux host backend that reads many PM25 / PM1006 sensors attached over
+ * USB serial adapters (or pseudo terminals) from a single thread, using the
+ * library's frame parser and AQI conversion. It lives outside src/ so that
+ * Arduino builds never see it.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_PM25AQI_GATEWAY_H
+#define ADAFRUIT_PM25AQI_GATEWAY_H
+#include "../../src/Adafruit_AQIUtils.h"
+#include "../../src/Adafruit_PM25AQI_Parser.h"
+#include <termios.h>
+
+#define PM25AQI_GATEWAY_MAX_STREAMS 16 ///< Most sensors on one gateway
+#define PM25AQI_GATEWAY_MAX_PATH 64    ///< Longest device path kept
+#define PM25AQI_GATEWAY_READ_SIZE 256  ///< Bytes read per read() call
+
+/*!
+ *  @brief  One decoded frame and where it came from
+ */
+typedef struct {
+  uint8_t stream;     ///< Index returned by open() or attach()
+  uint64_t timestamp; ///< CLOCK_REALTIME when the frame arrived, in us
+  PM25_AQI_Data data; ///< Decoded frame with the AQI values filled in
+} pm25aqi_reading_t;
+
+/*!
+ *  @brief  Function called for every decoded frame
+ *  @param  reading
+ *          The frame, only valid for the duration of the call
+ *  @param  context
+ *          Pointer given to setCallback()
+ */
+typedef void (*pm25aqi_reading_callback_t)(const pm25aqi_reading_t *reading,
+                                           void *context);
+
+/*!
+ *  @brief  Multiplexes up to PM25AQI_GATEWAY_MAX_STREAMS serial streams with
+ *          epoll. Each stream has its own parser; poll() waits for any of
+ *          them to have data, drains what is there without blocking and
+ *          hands every complete frame to the callback. A stream that hangs
+ *          up (adapter unplugged, pty closed) is closed. One opened by path
+ *          can be reopen()ed, an attach()ed one frees its index.
+ */
+class Adafruit_PM25AQI_Gateway {
+public:
+  Adafruit_PM25AQI_Gateway();
+  ~Adafruit_PM25AQI_Gateway();
+  bool begin();
+  int open(const char *path, bool is_pm1006 = false, speed_t baud = B9600);
+  int reserve(const char *path, bool is_pm1006 = false, speed_t baud = B9600);
+  int attach(int fd, bool is_pm1006 = false);
+  bool reopen(uint8_t stream);
+  void close(uint8_t stream);
+  void setCallback(pm25aqi_reading_callback_t callback, void *context);
+  int poll(int timeout_ms);
+
+  bool isOpen(uint8_t stream);
+  const char *path(uint8_t stream);
+  uint32_t frames(uint8_t stream);
+  uint32_t discarded(uint8_t stream);
+  uint32_t badChecksums(uint8_t stream);
+
+private:
+  /*!
+   *  @brief  State kept for each attached stream
+   */
+  struct Stream {
+    int fd = -1;                         ///< -1 when the slot is closed
+    bool owned = false;                  ///< close() the fd ourselves
+    bool used = false;                   ///< Slot has been handed out
+    speed_t baud = B9600;                ///< For reopen()
+    char path[PM25AQI_GATEWAY_MAX_PATH]; ///< Empty for attach()ed fds
+    Adafruit_PM25AQI_Parser parser;
+    uint32_t frames = 0;
+  };
+
+  int add(int fd, bool owned, bool is_pm1006, int slot);
+  bool drain(uint8_t stream);
+  static int openSerial(const char *path, speed_t baud);
+
+  int _epoll_fd = -1;
+  Stream _streams[PM25AQI_GATEWAY_MAX_STREAMS];
+  pm25aqi_reading_callback_t _callback = nullptr;
+  void *_context = nullptr;
+  Adafruit_AQIUtils _aqi_utils;
+};
+
+#endif // ADAFRUIT_PM25AQI_GATEWAY_H
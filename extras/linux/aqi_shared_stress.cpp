@@ -0,0 +1,94 @@
+/*!
+ * @file aqi_shared_stress.cpp
+ *
+ * Stress test for Adafruit_AQISharedData on a multi-core host. One thread
+ * publishes frames whose words all follow from the first one, as fast as it
+ * can, while several others read them back and check that no frame ever
+ * comes out torn (half old, half new):
+ *
+ *   aqi_shared_stress [readers] [frames]
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_AQISharedData.h"
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+#define STRESS_MAX_READERS 16 ///< Most reader threads
+#define STRESS_WORDS 19       ///< 16 bit words in PM25_AQI_Data
+
+/*!
+ *  @brief  Runs the stress test
+ *  @param  argc
+ *          Number of arguments
+ *  @param  argv
+ *          Optional reader count and number of frames to publish
+ *  @return 0 if every frame read was consistent
+ */
+int main(int argc, char **argv) {
+  int readers = (argc > 1) ? atoi(argv[1]) : 4;
+  unsigned long frames = (argc > 2) ? strtoul(argv[2], nullptr, 0) : 5000000;
+  Adafruit_AQISharedData shared;
+  std::atomic<bool> writing(true);
+  std::atomic<unsigned long> reads(0), torn(0);
+  std::thread threads[STRESS_MAX_READERS];
+
+  if (readers < 1 || readers > STRESS_MAX_READERS || frames < 1) {
+    fprintf(stderr, "usage: %s [readers 1-%d] [frames]\n", argv[0],
+            STRESS_MAX_READERS);
+    return 2;
+  }
+
+  PM25_AQI_Data data;
+  if (shared.latest(&data)) {
+    fprintf(stderr, "latest() returned a frame before any was published\n");
+    return 1;
+  }
+
+  for (int r = 0; r < readers; r++) {
+    threads[r] = std::thread([&]() {
+      PM25_AQI_Data frame;
+      uint16_t *words = (uint16_t *)&frame;
+      aqi_seq_t last = 0, sequence;
+      while (writing) {
+        if (!shared.latest(&frame, &sequence) || sequence == last) {
+          continue;
+        }
+        last = sequence;
+        reads++;
+        for (uint8_t i = 1; i < STRESS_WORDS; i++) {
+          if ((uint16_t)(words[i] - words[0]) != i) {
+            torn++;
+            break;
+          }
+        }
+      }
+    });
+  }
+
+  uint16_t *words = (uint16_t *)&data;
+  for (unsigned long k = 1; k <= frames; k++) {
+    for (uint8_t i = 0; i < STRESS_WORDS; i++) {
+      words[i] = (uint16_t)(k * 7 + i);
+    }
+    shared.publish(&data);
+  }
+  writing = false;
+  for (int r = 0; r < readers; r++) {
+    threads[r].join();
+  }
+
+  printf("%lu frames published, %lu new frames read by %d readers, %lu "
+         "torn, sequence %lu\n",
+         frames, reads.load(), readers, torn.load(),
+         (unsigned long)shared.sequence());
+  return (torn == 0 && shared.sequence() == 2 * frames) ? 0 : 1;
+}
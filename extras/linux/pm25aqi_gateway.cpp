@@ -0,0 +1,132 @@
+/*!
+ * @file pm25aqi_gateway.cpp
+ *
+ * Reads any number of PM25 / PM1006 sensors on serial ports and prints one
+ * CSV line per frame:
+ *
+ *   pm25aqi_gateway /dev/ttyUSB0 /dev/ttyUSB1 pm1006:/dev/ttyUSB2
+ *
+ * Devices that are missing at startup or disappear later are retried every
+ * second, so adapters can be plugged in, unplugged and plugged back in
+ * while it runs.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_PM25AQI_Gateway.h"
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static volatile sig_atomic_t running = 1;
+
+/*!
+ *  @brief  Stops the main loop on SIGINT / SIGTERM
+ *  @param  sig
+ *          Signal number
+ */
+static void stop(int sig) {
+  (void)sig;
+  running = 0;
+}
+
+/*!
+ *  @brief  Prints a frame as CSV
+ *  @param  reading
+ *          Frame from the gateway
+ *  @param  context
+ *          The gateway, for the device name
+ */
+static void print_reading(const pm25aqi_reading_t *reading, void *context) {
+  Adafruit_PM25AQI_Gateway *gateway = (Adafruit_PM25AQI_Gateway *)context;
+  const PM25_AQI_Data *d = &reading->data;
+
+  printf("%llu.%03u,%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+         (unsigned long long)(reading->timestamp / 1000000),
+         (unsigned)(reading->timestamp % 1000000 / 1000),
+         gateway->path(reading->stream), d->pm10_standard, d->pm25_standard,
+         d->pm100_standard, d->pm10_env, d->pm25_env, d->pm100_env,
+         d->particles_03um, d->particles_05um, d->particles_10um,
+         d->particles_25um, d->particles_50um, d->particles_100um,
+         d->aqi_pm25_us, d->aqi_pm100_us, d->aqi_pm25_china,
+         d->aqi_pm100_china);
+}
+
+/*!
+ *  @brief  Opens the devices given on the command line and prints their
+ *          frames until interrupted
+ *  @param  argc
+ *          Number of arguments
+ *  @param  argv
+ *          Devices to read, prefixed with pm1006: for Cubic sensors
+ *  @return 0 on a clean exit, 1 if epoll isn't available, 2 on bad usage
+ */
+int main(int argc, char **argv) {
+  Adafruit_PM25AQI_Gateway gateway;
+
+  if (argc < 2 || argc - 1 > PM25AQI_GATEWAY_MAX_STREAMS) {
+    fprintf(stderr, "usage: %s [pm1006:]device... (up to %d)\n", argv[0],
+            PM25AQI_GATEWAY_MAX_STREAMS);
+    return 2;
+  }
+  if (!gateway.begin()) {
+    perror("epoll");
+    return 1;
+  }
+
+  // Every device gets a stream even if it can't be opened yet, so the loop
+  // below keeps trying it
+  bool lost[PM25AQI_GATEWAY_MAX_STREAMS] = {false};
+  int devices = argc - 1;
+  for (int i = 0; i < devices; i++) {
+    const char *arg = argv[i + 1];
+    bool is_pm1006 = strncmp(arg, "pm1006:", 7) == 0;
+    const char *path = is_pm1006 ? arg + 7 : arg;
+    if (gateway.reserve(path, is_pm1006) != i) {
+      fprintf(stderr, "%s: path too long\n", path);
+      return 2;
+    }
+    if (!gateway.reopen(i)) {
+      perror(path);
+      lost[i] = true;
+    }
+  }
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+  gateway.setCallback(print_reading, &gateway);
+  printf("time,device,pm10_standard,pm25_standard,pm100_standard,pm10_env,"
+         "pm25_env,pm100_env,particles_03um,particles_05um,particles_10um,"
+         "particles_25um,particles_50um,particles_100um,aqi_pm25_us,"
+         "aqi_pm100_us,aqi_pm25_china,aqi_pm100_china\n");
+  fflush(stdout);
+
+  time_t last_retry = time(nullptr);
+  while (running) {
+    if (gateway.poll(1000) > 0) {
+      fflush(stdout);
+    }
+    time_t now = time(nullptr);
+    bool retry = (now != last_retry);
+    last_retry = now;
+    for (uint8_t i = 0; i < devices; i++) {
+      if (gateway.isOpen(i)) {
+        continue;
+      }
+      if (!lost[i]) {
+        fprintf(stderr, "%s: lost\n", gateway.path(i));
+        lost[i] = true;
+      } else if (retry && gateway.reopen(i)) {
+        fprintf(stderr, "%s: opened\n", gateway.path(i));
+        lost[i] = false;
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,192 @@
+/*!
+ * @file pm25aqi_gateway_bench.cpp
+ *
+ * Throughput benchmark for Adafruit_PM25AQI_Gateway. Creates a pseudo
+ * terminal per simulated sensor, writes numbered Plantower frames into them
+ * as fast as they are accepted and reads them back through the gateway,
+ * checking that none are lost or reordered. Reports how many 1 Hz sensors
+ * one core could keep up with:
+ *
+ *   pm25aqi_gateway_bench [sensors] [seconds] [frames per write]
+ *
+ * Real sensors arrive one frame per wakeup, which is the default; larger
+ * batches show the cost of the parser and AQI conversion alone.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_PM25AQI_Gateway.h"
+#include <atomic>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_BATCH 64 ///< Most frames per write() to each pty
+
+/*!
+ *  @brief  Per sensor bookkeeping for the reading side
+ */
+typedef struct {
+  uint32_t next[PM25AQI_GATEWAY_MAX_STREAMS]; ///< Next expected frame number
+  uint32_t errors;                            ///< Lost or reordered frames
+} bench_state_t;
+
+/*!
+ *  @brief  Builds a valid Plantower frame carrying a frame number
+ *  @param  frame
+ *          PM25AQI_FRAME_LEN bytes to fill
+ *  @param  number
+ *          Frame number, stored in pm25_env and particles_03um
+ */
+static void make_frame(uint8_t *frame, uint32_t number) {
+  uint16_t words[13] = {0};
+  words[4] = number & 0xFFFF;         // pm25_env
+  words[6] = (number >> 16) & 0xFFFF; // particles_03um
+  words[5] = 12;                      // pm100_env
+
+  frame[0] = 0x42;
+  frame[1] = 0x4D;
+  frame[2] = 0x00;
+  frame[3] = 0x1C;
+  for (uint8_t i = 0; i < 13; i++) {
+    frame[4 + i * 2] = words[i] >> 8;
+    frame[5 + i * 2] = words[i] & 0xFF;
+  }
+  uint16_t sum = 0;
+  for (uint8_t i = 0; i < PM25AQI_FRAME_LEN - 2; i++) {
+    sum += frame[i];
+  }
+  frame[30] = sum >> 8;
+  frame[31] = sum & 0xFF;
+}
+
+/*!
+ *  @brief  Checks each frame arrives in order
+ *  @param  reading
+ *          Frame from the gateway
+ *  @param  context
+ *          bench_state_t
+ */
+static void check_reading(const pm25aqi_reading_t *reading, void *context) {
+  bench_state_t *state = (bench_state_t *)context;
+  uint32_t number =
+      reading->data.pm25_env | ((uint32_t)reading->data.particles_03um << 16);
+  if (number != state->next[reading->stream]) {
+    state->errors++;
+  }
+  state->next[reading->stream] = number + 1;
+}
+
+/*!
+ *  @brief  Gets a clock in seconds
+ *  @param  id
+ *          CLOCK_MONOTONIC or CLOCK_THREAD_CPUTIME_ID
+ *  @return Seconds
+ */
+static double seconds(clockid_t id) {
+  struct timespec ts;
+  clock_gettime(id, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*!
+ *  @brief  Runs the benchmark
+ *  @param  argc
+ *          Number of arguments
+ *  @param  argv
+ *          Optional sensor count, duration and frames per write
+ *  @return 0 if every frame came through in order
+ */
+int main(int argc, char **argv) {
+  int sensors = (argc > 1) ? atoi(argv[1]) : PM25AQI_GATEWAY_MAX_STREAMS;
+  double duration = (argc > 2) ? atof(argv[2]) : 5;
+  int batch_frames = (argc > 3) ? atoi(argv[3]) : 1;
+  int masters[PM25AQI_GATEWAY_MAX_STREAMS];
+  Adafruit_PM25AQI_Gateway gateway;
+  bench_state_t state = {{0}, 0};
+
+  if (sensors < 1 || sensors > PM25AQI_GATEWAY_MAX_STREAMS || duration <= 0 ||
+      batch_frames < 1 || batch_frames > BENCH_MAX_BATCH) {
+    fprintf(stderr, "usage: %s [sensors 1-%d] [seconds] [frames 1-%d]\n",
+            argv[0], PM25AQI_GATEWAY_MAX_STREAMS, BENCH_MAX_BATCH);
+    return 2;
+  }
+
+  for (int i = 0; i < sensors; i++) {
+    masters[i] = posix_openpt(O_RDWR | O_NOCTTY);
+    if (masters[i] < 0 || grantpt(masters[i]) < 0 ||
+        unlockpt(masters[i]) < 0) {
+      perror("posix_openpt");
+      return 1;
+    }
+    if (gateway.open(ptsname(masters[i])) != i) {
+      perror(ptsname(masters[i]));
+      return 1;
+    }
+  }
+  gateway.setCallback(check_reading, &state);
+
+  // One writer thread stands in for all the sensors
+  std::atomic<bool> writing(true);
+  uint32_t written = 0;
+  std::thread writer([&]() {
+    uint8_t batch[BENCH_MAX_BATCH * PM25AQI_FRAME_LEN];
+    ssize_t batch_len = batch_frames * PM25AQI_FRAME_LEN;
+    uint32_t number = 0;
+    double end = seconds(CLOCK_MONOTONIC) + duration;
+    while (seconds(CLOCK_MONOTONIC) < end) {
+      for (int f = 0; f < batch_frames; f++) {
+        make_frame(batch + f * PM25AQI_FRAME_LEN, number + f);
+      }
+      for (int i = 0; i < sensors; i++) {
+        if (write(masters[i], batch, batch_len) != batch_len) {
+          perror("write");
+          exit(1);
+        }
+      }
+      number += batch_frames;
+    }
+    written = number;
+    writing = false;
+  });
+
+  double start = seconds(CLOCK_MONOTONIC);
+  double cpu_start = seconds(CLOCK_THREAD_CPUTIME_ID);
+  uint64_t frames = 0;
+  while (true) {
+    int n = gateway.poll(100);
+    if (n < 0) {
+      break;
+    }
+    frames += n;
+    if (n == 0 && !writing) {
+      break; // writer done and nothing left in flight
+    }
+  }
+  double wall = seconds(CLOCK_MONOTONIC) - start;
+  double cpu = seconds(CLOCK_THREAD_CPUTIME_ID) - cpu_start;
+  writer.join();
+
+  uint64_t expected = (uint64_t)written * sensors;
+  uint64_t discarded = 0;
+  for (int i = 0; i < sensors; i++) {
+    discarded += gateway.discarded(i);
+    close(masters[i]);
+  }
+  printf("%d sensors, %llu of %llu frames, %u out of order, %llu bytes "
+         "discarded\n",
+         sensors, (unsigned long long)frames, (unsigned long long)expected,
+         state.errors, (unsigned long long)discarded);
+  printf("%.0f frames/s, reader %.0f%% of a core, %.2f us CPU per frame\n",
+         frames / wall, 100 * cpu / wall, 1e6 * cpu / frames);
+  printf("~%.0f sensors at 1 frame/s per core\n", frames / cpu);
+  return (frames == expected && state.errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+/*!
+ * @file pm25aqi_parser_fuzz.cpp
+ *
+ * Fuzz test for Adafruit_PM25AQI_Parser. Builds a stream of numbered
+ * Plantower frames, every 7th with a false 42 4D start sequence in its
+ * payload, flips random bits at a few bit error rates and feeds the stream
+ * through the parser one byte at a time:
+ *
+ *   pm25aqi_parser_fuzz [frames] [seed]
+ *
+ * For each rate it reports how many uncorrupted frames were decoded, how
+ * many were lost (recovery after a corrupted frame should cost none) and
+ * how many corrupted or misaligned frames were accepted anyway.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_PM25AQI_Parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#define FUZZ_FRAME_LEN 32 ///< Bytes in a Plantower frame
+
+/*!
+ *  @brief  Small deterministic generator, so a seed gives the same stream
+ *          on every libc
+ *  @param  state
+ *          Generator state, not 0
+ *  @return Next pseudo random number
+ */
+static uint32_t xorshift(uint32_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 17;
+  *state ^= *state << 5;
+  return *state;
+}
+
+/*!
+ *  @brief  Builds a valid Plantower frame carrying a frame number
+ *  @param  frame
+ *          FUZZ_FRAME_LEN bytes to fill
+ *  @param  number
+ *          Frame number, stored in pm25_env
+ *  @param  false_start
+ *          True to put 42 4D in the payload, where a naive framer would
+ *          resynchronize
+ */
+static void make_frame(uint8_t *frame, uint16_t number, bool false_start) {
+  uint16_t words[14] = {28, number, number, number, number, number,
+                        number, 0, 7, 6, 5, 4, 3, 0x9700};
+  words[7] = number * 3; // particles_03um
+  frame[0] = 0x42;
+  frame[1] = 0x4D;
+  for (uint8_t i = 0; i < 14; i++) {
+    frame[2 + i * 2] = words[i] >> 8;
+    frame[3 + i * 2] = words[i] & 0xFF;
+  }
+  if (false_start) {
+    frame[6] = 0x42;
+    frame[7] = 0x4D;
+  }
+  uint16_t sum = 0;
+  for (uint8_t i = 0; i < FUZZ_FRAME_LEN - 2; i++) {
+    sum += frame[i];
+  }
+  frame[30] = sum >> 8;
+  frame[31] = sum & 0xFF;
+}
+
+/*!
+ *  @brief  Runs one bit error rate
+ *  @param  frames
+ *          Number of frames in the stream
+ *  @param  ber
+ *          Probability of each bit being flipped
+ *  @param  seed
+ *          Generator seed, not 0
+ *  @return Number of uncorrupted frames that were not decoded
+ */
+static size_t run(size_t frames, double ber, uint32_t seed) {
+  std::vector<uint8_t> stream;
+  std::vector<bool> corrupted(frames, false), decoded(frames, false);
+  uint32_t state = seed;
+  uint32_t threshold = (uint32_t)(ber * 4294967295.0);
+
+  for (size_t k = 0; k < frames; k++) {
+    uint8_t frame[FUZZ_FRAME_LEN];
+    make_frame(frame, k & 0xFFFF, k % 7 == 0);
+    for (uint8_t i = 0; i < FUZZ_FRAME_LEN; i++) {
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        if (xorshift(&state) < threshold) {
+          frame[i] ^= 1 << bit;
+          corrupted[k] = true;
+        }
+      }
+      stream.push_back(frame[i]);
+    }
+  }
+
+  Adafruit_PM25AQI_Parser parser;
+  size_t misaligned = 0, accepted_corrupt = 0;
+  for (size_t i = 0; i < stream.size(); i++) {
+    if (!parser.push(stream[i])) {
+      continue;
+    }
+    PM25_AQI_Data data;
+    parser.decode(&data);
+    size_t k = i / FUZZ_FRAME_LEN;
+    if (i % FUZZ_FRAME_LEN != FUZZ_FRAME_LEN - 1) {
+      misaligned++; // ended mid frame, made of two frames' bytes
+    } else if (corrupted[k]) {
+      accepted_corrupt++; // bit flips the checksum didn't catch
+    } else if (data.pm25_env == (k & 0xFFFF)) {
+      decoded[k] = true;
+    }
+  }
+
+  size_t clean = 0, clean_decoded = 0;
+  for (size_t k = 0; k < frames; k++) {
+    if (!corrupted[k]) {
+      clean++;
+      clean_decoded += decoded[k];
+    }
+  }
+  printf("BER %.0e: %zu frames, %zu corrupted, %zu of %zu clean decoded, "
+         "%zu corrupted accepted, %zu misaligned accepted, %lu bytes "
+         "discarded, %lu bad checksums\n",
+         ber, frames, frames - clean, clean_decoded, clean, accepted_corrupt,
+         misaligned, (unsigned long)parser.discarded(),
+         (unsigned long)parser.badChecksums());
+  return clean - clean_decoded;
+}
+
+/*!
+ *  @brief  Runs the fuzz test at bit error rates of 1e-4, 1e-3 and 1e-2
+ *  @param  argc
+ *          Number of arguments
+ *  @param  argv
+ *          Optional frame count and seed
+ *  @return 0 if every uncorrupted frame was decoded
+ */
+int main(int argc, char **argv) {
+  size_t frames = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 20000;
+  uint32_t seed = (argc > 2) ? strtoul(argv[2], nullptr, 0) : 42;
+  const double rates[] = {1e-4, 1e-3, 1e-2};
+  size_t lost = 0;
+
+  if (frames < 1 || seed == 0) {
+    fprintf(stderr, "usage: %s [frames] [seed, not 0]\n", argv[0]);
+    return 2;
+  }
+  for (uint8_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+    lost += run(frames, rates[r], seed);
+  }
+  return lost ? 1 : 0;
+}
@@ -0,0 +1,251 @@
+/*!
+ * @file pm25aqi_telemetry_ratio.cpp
+ *
+ * Measures how well Adafruit_AQITelemetry compresses a stream of frames.
+ * Given a CSV log written by pm25aqi_gateway it packs each device's frames
+ * in order, unpacks them again and reports the average payload size against
+ * the 38 byte PM25_AQI_Data, and the largest error on any sent field:
+ *
+ *   pm25aqi_gateway /dev/ttyUSB0 > log.csv
+ *   pm25aqi_telemetry_ratio log.csv
+ *
+ * Without a log it runs a synthetic PM2.5 random walk with occasional
+ * spikes instead, which is only a rough stand-in for a real sensor.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_AQITelemetry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RATIO_MAX_DEVICES 16        ///< Devices tracked in one log
+#define RATIO_MAX_PATH 64           ///< Longest device name kept
+#define RATIO_SYNTHETIC_FRAMES 5000 ///< Frames in the synthetic walk
+
+/*!
+ *  @brief  One packer / unpacker pair and its statistics
+ */
+typedef struct {
+  Adafruit_AQITelemetry encoder; ///< Sending end
+  Adafruit_AQITelemetry decoder; ///< Receiving end
+  bool count_03um;               ///< Also send particles_03um
+  unsigned long frames;          ///< Frames packed
+  unsigned long bytes;           ///< Payload bytes sent
+  unsigned long undecodable;     ///< Payloads the decoder refused
+  unsigned max_error;            ///< Largest error on a sent field
+} ratio_config_t;
+
+/*!
+ *  @brief  Sets up a configuration: the default env PM fields, optionally
+ *          with the 0.3um count quantized to 8 counts
+ *  @param  config
+ *          Configuration to set up
+ *  @param  count_03um
+ *          True to add particles_03um
+ */
+static void config_init(ratio_config_t *config, bool count_03um) {
+  config->count_03um = count_03um;
+  if (count_03um) {
+    config->encoder.setField(AQI_PACK_PARTICLES_03UM, 3, 6);
+    config->decoder.setField(AQI_PACK_PARTICLES_03UM, 3, 6);
+  }
+  config->frames = 0;
+  config->bytes = 0;
+  config->undecodable = 0;
+  config->max_error = 0;
+}
+
+/*!
+ *  @brief  Packs and unpacks one frame, checking what comes out
+ *  @param  config
+ *          Configuration to run the frame through
+ *  @param  data
+ *          Frame to send
+ */
+static void config_frame(ratio_config_t *config, const PM25_AQI_Data *data) {
+  uint8_t payload[PM25AQI_TELEMETRY_MAX_PAYLOAD];
+  PM25_AQI_Data out;
+  size_t len = config->encoder.encode(data, payload, sizeof(payload));
+
+  config->frames++;
+  config->bytes += len;
+  if (!config->decoder.decode(payload, len, &out)) {
+    config->undecodable++;
+    return;
+  }
+  const uint16_t sent[] = {AQI_PACK_PM10_ENV, AQI_PACK_PM25_ENV,
+                           AQI_PACK_PM100_ENV, AQI_PACK_PARTICLES_03UM};
+  const uint16_t *in_words = (const uint16_t *)data;
+  const uint16_t *out_words = (const uint16_t *)&out;
+  for (uint8_t i = 0; i < (config->count_03um ? 4 : 3); i++) {
+    int error = abs((int)in_words[sent[i]] - (int)out_words[sent[i]]);
+    if ((unsigned)error > config->max_error) {
+      config->max_error = error;
+    }
+  }
+}
+
+/*!
+ *  @brief  Prints a configuration's results
+ *  @param  name
+ *          What the configuration sends
+ *  @param  config
+ *          Configuration to report
+ */
+static void config_report(const char *name, ratio_config_t *config) {
+  if (!config->frames) {
+    return;
+  }
+  double average = (double)config->bytes / config->frames;
+  printf("%s: keyframe %zu B, delta %zu B, %lu frames, %.2f B/frame, "
+         "%.1fx, max error %u, %lu undecodable\n",
+         name, config->encoder.keyframeSize(), config->encoder.deltaSize(),
+         config->frames, average, sizeof(PM25_AQI_Data) / average,
+         config->max_error, config->undecodable);
+}
+
+/*!
+ *  @brief  Small deterministic generator, so the synthetic walk is the same
+ *          on every libc
+ *  @param  state
+ *          Generator state, not 0
+ *  @return Next pseudo random number
+ */
+static uint32_t xorshift(uint32_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 17;
+  *state ^= *state << 5;
+  return *state;
+}
+
+/*!
+ *  @brief  Runs a synthetic PM2.5 random walk with occasional spikes
+ *  @param  configs
+ *          The two configurations to feed
+ */
+static void run_synthetic(ratio_config_t *configs) {
+  uint32_t state = 1;
+  double pm = 12;
+
+  for (int k = 0; k < RATIO_SYNTHETIC_FRAMES; k++) {
+    pm += ((int)(xorshift(&state) % 7) - 3) * 0.5;
+    if (pm < 0) {
+      pm = 0;
+    }
+    if (xorshift(&state) % 300 == 0) {
+      pm += 80; // something burning nearby
+    }
+    if (pm > 400) {
+      pm = 50;
+    }
+    PM25_AQI_Data data;
+    memset(&data, 0, sizeof(data));
+    data.pm25_env = pm;
+    data.pm10_env = pm * 0.7;
+    data.pm100_env = pm * 1.3 + xorshift(&state) % 3;
+    data.particles_03um = pm * 150 + xorshift(&state) % 40;
+    config_frame(&configs[0], &data);
+    config_frame(&configs[1], &data);
+  }
+}
+
+/*!
+ *  @brief  Reads a pm25aqi_gateway CSV log, one configuration pair per
+ *          device
+ *  @param  file
+ *          Open log
+ *  @param  configs
+ *          Two configurations per device, RATIO_MAX_DEVICES * 2
+ *  @return Number of devices seen, -1 if there were too many
+ */
+static int run_log(FILE *file, ratio_config_t *configs) {
+  char devices[RATIO_MAX_DEVICES][RATIO_MAX_PATH];
+  char line[512];
+  int count = 0;
+
+  while (fgets(line, sizeof(line), file)) {
+    char device[RATIO_MAX_PATH];
+    unsigned v[16];
+    if (sscanf(line,
+               "%*[^,],%63[^,],%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,"
+               "%u",
+               device, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6],
+               &v[7], &v[8], &v[9], &v[10], &v[11], &v[12], &v[13], &v[14],
+               &v[15]) != 17) {
+      continue; // header or a truncated line
+    }
+    int d = 0;
+    while (d < count && strcmp(devices[d], device) != 0) {
+      d++;
+    }
+    if (d == count) {
+      if (count == RATIO_MAX_DEVICES) {
+        return -1;
+      }
+      strcpy(devices[count++], device);
+      config_init(&configs[d * 2], false);
+      config_init(&configs[d * 2 + 1], true);
+    }
+
+    // CSV columns are words 1-12 then 15-18 of PM25_AQI_Data
+    PM25_AQI_Data data;
+    memset(&data, 0, sizeof(data));
+    uint16_t *words = (uint16_t *)&data;
+    for (uint8_t i = 0; i < 16; i++) {
+      words[i < 12 ? i + 1 : i + 3] = v[i];
+    }
+    config_frame(&configs[d * 2], &data);
+    config_frame(&configs[d * 2 + 1], &data);
+  }
+  for (int d = 0; d < count; d++) {
+    printf("%s\n", devices[d]);
+    config_report("  env PM", &configs[d * 2]);
+    config_report("  env PM + 0.3um/8", &configs[d * 2 + 1]);
+  }
+  return count;
+}
+
+/*!
+ *  @brief  Runs the measurement
+ *  @param  argc
+ *          Number of arguments
+ *  @param  argv
+ *          Optional CSV log, - for stdin
+ *  @return 0 on success, 1 if the log could not be read
+ */
+int main(int argc, char **argv) {
+  static ratio_config_t configs[RATIO_MAX_DEVICES * 2];
+
+  if (argc < 2) {
+    config_init(&configs[0], false);
+    config_init(&configs[1], true);
+    run_synthetic(configs);
+    printf("synthetic random walk\n");
+    config_report("  env PM", &configs[0]);
+    config_report("  env PM + 0.3um/8", &configs[1]);
+    return 0;
+  }
+
+  FILE *file = strcmp(argv[1], "-") ? fopen(argv[1], "r") : stdin;
+  if (!file) {
+    perror(argv[1]);
+    return 1;
+  }
+  int devices = run_log(file, configs);
+  if (devices < 0) {
+    fprintf(stderr, "more than %d devices in the log\n", RATIO_MAX_DEVICES);
+    return 1;
+  }
+  if (devices == 0) {
+    fprintf(stderr, "%s: no frames\n", argv[1]);
+    return 1;
+  }
+  return 0;
+}
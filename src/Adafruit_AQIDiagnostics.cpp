@@ -0,0 +1,224 @@
+/*!
+ * @file Adafruit_AQIDiagnostics.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_AQIDiagnostics.h"
+
+#define DIAG_FRAC_BITS 12        ///< Fixed point fraction of the baseline
+#define DIAG_SETTLE_FRAMES 256   ///< Clean frames averaged for the reference
+#define DIAG_SLOW_SHIFT 12       ///< Baseline time constant after settling
+#define DIAG_ZERO_FRAMES 60      ///< Frames of all zero output to flag
+#define DIAG_SATURATED_FRAMES 10 ///< Frames at full scale to flag
+
+/*!
+ *  @brief  Instantiates a new diagnostics tracker
+ */
+Adafruit_AQIDiagnostics::Adafruit_AQIDiagnostics() {}
+
+/*!
+ *  @brief  Forgets all history, including the reference baseline. Call
+ *          after cleaning or replacing the sensor.
+ */
+void Adafruit_AQIDiagnostics::reset() {
+  _baseline = 0;
+  _reference = 0;
+  _clean_frames = 0;
+  _zero_frames = 0;
+  _saturated_frames = 0;
+  _version = 0;
+  _error = 0;
+}
+
+/*!
+ *  @brief  Sets the PM2.5 level at or below which the air counts as clean,
+ *          so the frame feeds the baseline
+ *  @param  pm25_ugm3
+ *          Environmental PM2.5 in ug/m3, 5 by default
+ */
+void Adafruit_AQIDiagnostics::setCleanAir(uint16_t pm25_ugm3) {
+  _clean_air = pm25_ugm3;
+}
+
+/*!
+ *  @brief  Sets how far the baseline may move from the reference before
+ *          PM25AQI_DIAG_DRIFT is raised
+ *  @param  percent
+ *          Allowed drift in percent, 30 by default
+ */
+void Adafruit_AQIDiagnostics::setDriftLimit(uint8_t percent) {
+  _drift_limit = percent;
+}
+
+/*!
+ *  @brief  Gets the firmware version byte from a frame
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct
+ *  @return High byte of the version + error code word
+ */
+uint8_t Adafruit_AQIDiagnostics::versionOf(const PM25_AQI_Data *data) {
+  return data->unused >> 8;
+}
+
+/*!
+ *  @brief  Gets the error code byte from a frame
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct
+ *  @return Low byte of the version + error code word, 0 when healthy
+ */
+uint8_t Adafruit_AQIDiagnostics::errorCodeOf(const PM25_AQI_Data *data) {
+  return data->unused & 0xFF;
+}
+
+/*!
+ *  @brief  Feeds one successfully read frame to the tracker
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct
+ */
+void Adafruit_AQIDiagnostics::update(const PM25_AQI_Data *data) {
+  if (!data) {
+    return;
+  }
+
+  _version = versionOf(data);
+  _error = errorCodeOf(data);
+
+  // Dead fan or laser reads exactly zero everywhere, even clean air has
+  // hundreds of 0.3um particles per 0.1L
+  if (data->particles_03um == 0 && data->pm25_env == 0 &&
+      data->pm100_env == 0) {
+    if (_zero_frames < 0xFF) {
+      _zero_frames++;
+    }
+    return; // don't let it drag the baseline down
+  }
+  _zero_frames = 0;
+
+  if (data->pm25_env >= PM25AQI_DIAG_SATURATION ||
+      data->pm100_env >= PM25AQI_DIAG_SATURATION ||
+      data->particles_03um == 0xFFFF) {
+    if (_saturated_frames < 0xFF) {
+      _saturated_frames++;
+    }
+  } else {
+    _saturated_frames = 0;
+  }
+
+  if (data->pm25_env > _clean_air) {
+    return;
+  }
+
+  // Running mean until the reference is taken, then a slow moving average
+  int32_t sample = (int32_t)data->particles_03um << DIAG_FRAC_BITS;
+  int32_t diff = sample - (int32_t)_baseline;
+  if (_clean_frames < DIAG_SETTLE_FRAMES) {
+    _clean_frames++;
+    _baseline += diff / _clean_frames;
+    if (_clean_frames == DIAG_SETTLE_FRAMES) {
+      _reference = baseline() ? baseline() : 1;
+    }
+  } else {
+    _baseline += diff / (1 << DIAG_SLOW_SHIFT);
+  }
+}
+
+/*!
+ *  @brief  Gets the firmware version byte of the last frame
+ *  @return Version
+ */
+uint8_t Adafruit_AQIDiagnostics::version() { return _version; }
+
+/*!
+ *  @brief  Gets the error code byte of the last frame
+ *  @return Error code, 0 when healthy
+ */
+uint8_t Adafruit_AQIDiagnostics::errorCode() { return _error; }
+
+/*!
+ *  @brief  Gets the current clean air 0.3um particle count baseline
+ *  @return Particles per 0.1L, 0 until there has been clean air
+ */
+uint16_t Adafruit_AQIDiagnostics::baseline() {
+  return (_baseline + (1 << (DIAG_FRAC_BITS - 1))) >> DIAG_FRAC_BITS;
+}
+
+/*!
+ *  @brief  Gets the reference baseline, the average of the first 256 clean
+ *          air frames
+ *  @return Particles per 0.1L, 0 until established
+ */
+uint16_t Adafruit_AQIDiagnostics::reference() { return _reference; }
+
+/*!
+ *  @brief  Gets how far the baseline has moved from the reference
+ *  @return Percent, positive when the baseline rose, capped at 1000. 0 until
+ *          the reference is established.
+ */
+int16_t Adafruit_AQIDiagnostics::drift() {
+  if (_reference == 0) {
+    return 0;
+  }
+  int32_t percent = ((int32_t)baseline() - _reference) * 100 / _reference;
+  if (percent > 1000) {
+    percent = 1000;
+  }
+  return percent;
+}
+
+/*!
+ *  @brief  Gets the problems currently detected
+ *  @return Bitmask of PM25AQI_DIAG_ERROR, PM25AQI_DIAG_ZERO,
+ *          PM25AQI_DIAG_SATURATED and PM25AQI_DIAG_DRIFT
+ */
+uint8_t Adafruit_AQIDiagnostics::faults() {
+  uint8_t faults = 0;
+  if (_error) {
+    faults |= PM25AQI_DIAG_ERROR;
+  }
+  if (_zero_frames >= DIAG_ZERO_FRAMES) {
+    faults |= PM25AQI_DIAG_ZERO;
+  }
+  if (_saturated_frames >= DIAG_SATURATED_FRAMES) {
+    faults |= PM25AQI_DIAG_SATURATED;
+  }
+  int16_t drifted = drift();
+  if (drifted < 0) {
+    drifted = -drifted;
+  }
+  if (drifted > _drift_limit) {
+    faults |= PM25AQI_DIAG_DRIFT;
+  }
+  return faults;
+}
+
+/*!
+ *  @brief  Gets an overall health score. An error code costs 50 points,
+ *          zero output 60, saturation 20 (it may be real smoke) and drift
+ *          one point per percent past the limit, up to 40.
+ *  @return 100 for a healthy sensor down to 0
+ */
+uint8_t Adafruit_AQIDiagnostics::health() {
+  int16_t score = 100;
+  uint8_t f = faults();
+  if (f & PM25AQI_DIAG_ERROR) {
+    score -= 50;
+  }
+  if (f & PM25AQI_DIAG_ZERO) {
+    score -= 60;
+  }
+  if (f & PM25AQI_DIAG_SATURATED) {
+    score -= 20;
+  }
+  if (f & PM25AQI_DIAG_DRIFT) {
+    int16_t excess = drift();
+    excess = (excess < 0 ? -excess : excess) - _drift_limit;
+    score -= (excess > 40) ? 40 : excess;
+  }
+  return (score < 0) ? 0 : score;
+}
@@ -0,0 +1,66 @@
+/*!
+ * @file Adafruit_AQIDiagnostics.h
+ *
+ * Sensor health tracking derived from the PM25_AQI_Data frame stream:
+ * version/error word decoding, clean air baseline drift, dead (all zero)
+ * and saturated output.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_AQIDIAGNOSTICS_H
+#define ADAFRUIT_AQIDIAGNOSTICS_H
+#include "Adafruit_PM25AQI_Data.h"
+
+#define PM25AQI_DIAG_ERROR 0x01     ///< Sensor reports a non-zero error code
+#define PM25AQI_DIAG_ZERO 0x02      ///< Output stuck at zero (fan/laser dead)
+#define PM25AQI_DIAG_SATURATED 0x04 ///< Output pinned at full scale
+#define PM25AQI_DIAG_DRIFT 0x08     ///< Clean air baseline has drifted
+
+#define PM25AQI_DIAG_SATURATION 1000 ///< ug/m3 treated as full scale
+
+/*!
+ *  @brief  Tracks the health of one Plantower sensor from its frames. The
+ *          baseline is an average of the 0.3um particle count taken only
+ *          while the air is clean. The first one established is kept as a
+ *          reference, and the baseline wandering away from it signals a
+ *          dirty optical path (baseline up) or a weak fan or laser
+ *          (baseline down). Every update is O(1), state is 16 bytes.
+ */
+class Adafruit_AQIDiagnostics {
+public:
+  Adafruit_AQIDiagnostics();
+  void update(const PM25_AQI_Data *data);
+  void reset();
+  void setCleanAir(uint16_t pm25_ugm3);
+  void setDriftLimit(uint8_t percent);
+
+  uint8_t version();
+  uint8_t errorCode();
+  uint16_t baseline();
+  uint16_t reference();
+  int16_t drift();
+  uint8_t faults();
+  uint8_t health();
+
+  static uint8_t versionOf(const PM25_AQI_Data *data);
+  static uint8_t errorCodeOf(const PM25_AQI_Data *data);
+
+private:
+  uint32_t _baseline = 0;  ///< 0.3um count, 12 fractional bits
+  uint16_t _reference = 0; ///< First settled baseline, 0 until then
+  uint16_t _clean_frames = 0;
+  uint16_t _clean_air = 5;
+  uint8_t _drift_limit = 30;
+  uint8_t _zero_frames = 0;
+  uint8_t _saturated_frames = 0;
+  uint8_t _version = 0;
+  uint8_t _error = 0;
+};
+
+#endif // ADAFRUIT_AQIDIAGNOSTICS_H
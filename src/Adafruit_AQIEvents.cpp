@@ -0,0 +1,321 @@
+/*!
+ * @file Adafruit_AQIEvents.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_AQIEvents.h"
+
+/*!
+ *  @brief  Instantiates a new event detector with nothing but category
+ *          change events enabled.
+ */
+Adafruit_AQIEvents::Adafruit_AQIEvents() {
+  for (uint8_t i = 0; i < PM25AQI_EVENT_MAX_THRESHOLDS; i++) {
+    _thresholds[i].enabled = false;
+  }
+  reset();
+}
+
+/*!
+ *  @brief  Sets the function called for each event raised by update()
+ *  @param  callback
+ *          Function to call, or nullptr to only count events
+ *  @param  context
+ *          Opaque pointer handed back to the callback
+ */
+void Adafruit_AQIEvents::setCallback(aqi_event_callback_t callback,
+                                     void *context) {
+  _callback = callback;
+  _context = context;
+}
+
+// Lowest AQI of each category returned by aqiCategory()
+static const uint16_t category_floor[] = {0, 51, 101, 151, 201, 301};
+
+/*!
+ *  @brief  Sets how far the AQI must drop below a category's lower bound
+ *          before a lower category is reported, to stop flapping at edges.
+ *  @param  aqi_points
+ *          Hysteresis in AQI points, 0 to disable
+ */
+void Adafruit_AQIEvents::setCategoryHysteresis(uint8_t aqi_points) {
+  _category_hysteresis = aqi_points;
+}
+
+/*!
+ *  @brief  Configures a threshold. A rise event is raised when the field
+ *          reaches level, a fall event when it then drops below
+ *          level - hysteresis.
+ *  @param  slot
+ *          Threshold slot, 0 to PM25AQI_EVENT_MAX_THRESHOLDS - 1
+ *  @param  field
+ *          Which field of the frame to watch
+ *  @param  level
+ *          Threshold value
+ *  @param  hysteresis
+ *          Distance below level the field must fall to re-arm
+ *  @return True if the slot is valid, false otherwise
+ */
+bool Adafruit_AQIEvents::setThreshold(uint8_t slot, aqi_field_t field,
+                                      uint16_t level, uint16_t hysteresis) {
+  if (slot >= PM25AQI_EVENT_MAX_THRESHOLDS) {
+    return false;
+  }
+  _thresholds[slot].field = field;
+  _thresholds[slot].level = level;
+  _thresholds[slot].hysteresis = min(hysteresis, level);
+  _thresholds[slot].enabled = true;
+  _thresholds[slot].above = false;
+  return true;
+}
+
+/*!
+ *  @brief  Disables a threshold slot
+ *  @param  slot
+ *          Threshold slot, 0 to PM25AQI_EVENT_MAX_THRESHOLDS - 1
+ *  @return True if the slot is valid, false otherwise
+ */
+bool Adafruit_AQIEvents::clearThreshold(uint8_t slot) {
+  if (slot >= PM25AQI_EVENT_MAX_THRESHOLDS) {
+    return false;
+  }
+  _thresholds[slot].enabled = false;
+  return true;
+}
+
+/*!
+ *  @brief  Configures rate-of-change detection between consecutive frames
+ *  @param  field
+ *          Which field of the frame to watch
+ *  @param  delta
+ *          A change larger than this raises a spike event, 0 to disable
+ */
+void Adafruit_AQIEvents::setSpike(aqi_field_t field, uint16_t delta) {
+  _spike_field = field;
+  _spike_delta = delta;
+}
+
+/*!
+ *  @brief  Configures stuck sensor detection
+ *  @param  frames
+ *          Number of identical frames in a row that count as stuck, 0 to
+ *          disable. A healthy sensor's particle counts change nearly every
+ *          frame, so a few dozen is a reasonable value at 1 frame/second.
+ */
+void Adafruit_AQIEvents::setStuckFrames(uint16_t frames) {
+  _stuck_frames = frames;
+}
+
+/*!
+ *  @brief  Forgets all history, so the next frame is treated as the first.
+ *          Configuration is kept.
+ */
+void Adafruit_AQIEvents::reset() {
+  for (uint8_t i = 0; i < AQI_SCALE_COUNT; i++) {
+    _category[i] = AQI_CATEGORY_NONE;
+  }
+  for (uint8_t i = 0; i < PM25AQI_EVENT_MAX_THRESHOLDS; i++) {
+    _thresholds[i].above = false;
+  }
+  _same_count = 0;
+  _last_hash = 0;
+  _last_spike_value = 0;
+  _have_previous = false;
+}
+
+/*!
+ *  @brief  Gets the category last reported for a scale
+ *  @param  scale
+ *          The AQI scale
+ *  @return Category 0 (good) to 5 (hazardous), or AQI_CATEGORY_NONE
+ */
+uint8_t Adafruit_AQIEvents::category(aqi_scale_t scale) {
+  if (scale >= AQI_SCALE_COUNT) {
+    return AQI_CATEGORY_NONE;
+  }
+  return _category[scale];
+}
+
+/*!
+ *  @brief  Maps an AQI to its category. The US and China scales share the
+ *          same breakpoints, only the names differ.
+ *  @param  aqi
+ *          AQI value
+ *  @return 0 (0-50), 1 (51-100), 2 (101-150), 3 (151-200), 4 (201-300)
+ *          or 5 (301 and above)
+ */
+uint8_t Adafruit_AQIEvents::aqiCategory(uint16_t aqi) {
+  if (aqi <= 50) {
+    return 0;
+  } else if (aqi <= 100) {
+    return 1;
+  } else if (aqi <= 150) {
+    return 2;
+  } else if (aqi <= 200) {
+    return 3;
+  } else if (aqi <= 300) {
+    return 4;
+  }
+  return 5;
+}
+
+/*!
+ *  @brief  Reads one field out of a frame
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct
+ *  @param  field
+ *          Which field to read
+ *  @return The field's value
+ */
+uint16_t Adafruit_AQIEvents::fieldValue(const PM25_AQI_Data *data,
+                                        aqi_field_t field) {
+  switch (field) {
+  case AQI_FIELD_PM10_ENV:
+    return data->pm10_env;
+  case AQI_FIELD_PM25_ENV:
+    return data->pm25_env;
+  case AQI_FIELD_PM100_ENV:
+    return data->pm100_env;
+  case AQI_FIELD_PARTICLES_03UM:
+    return data->particles_03um;
+  case AQI_FIELD_AQI_PM25_US:
+    return data->aqi_pm25_us;
+  case AQI_FIELD_AQI_PM100_US:
+    return data->aqi_pm100_us;
+  case AQI_FIELD_AQI_PM25_CHINA:
+    return data->aqi_pm25_china;
+  case AQI_FIELD_AQI_PM100_CHINA:
+    return data->aqi_pm100_china;
+  }
+  return 0;
+}
+
+/*!
+ *  @brief  Cheap 16 bit hash of the measured fields of a frame, used to spot
+ *          a sensor that keeps sending the same frame without storing it.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct
+ *  @return Hash of pm10_standard through unused
+ */
+uint16_t Adafruit_AQIEvents::frameHash(const PM25_AQI_Data *data) {
+  const uint16_t *words = &data->pm10_standard;
+  uint16_t hash = 0;
+  for (uint8_t i = 0; i < 13; i++) {
+    hash = hash * 31 + words[i];
+  }
+  return hash;
+}
+
+/*!
+ *  @brief  Fills in an event and hands it to the callback
+ *  @param  type
+ *          Event type
+ *  @param  source
+ *          Scale, threshold slot or field the event came from
+ *  @param  previous
+ *          Value before the event
+ *  @param  current
+ *          Value after the event
+ *  @return 1, so callers can sum up events raised
+ */
+uint8_t Adafruit_AQIEvents::raise(aqi_event_type_t type, uint8_t source,
+                                  uint16_t previous, uint16_t current) {
+  if (_callback) {
+    aqi_event_t event;
+    event.type = type;
+    event.source = source;
+    event.previous = previous;
+    event.current = current;
+    _callback(&event, _context);
+  }
+  return 1;
+}
+
+/*!
+ *  @brief  Feeds one successfully read frame through the detectors, calling
+ *          the callback for every event. On the first frame after reset()
+ *          the initial categories and any thresholds already exceeded are
+ *          reported.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct, after ConvertAQIData()
+ *  @return Number of events raised
+ */
+uint8_t Adafruit_AQIEvents::update(const PM25_AQI_Data *data) {
+  uint8_t events = 0;
+
+  if (!data) {
+    return 0;
+  }
+
+  // AQI category changes on each scale
+  const uint16_t aqi[AQI_SCALE_COUNT] = {data->aqi_pm25_us, data->aqi_pm100_us,
+                                         data->aqi_pm25_china,
+                                         data->aqi_pm100_china};
+  for (uint8_t i = 0; i < AQI_SCALE_COUNT; i++) {
+    uint8_t prev = _category[i];
+    uint8_t cat = aqiCategory(aqi[i]);
+    if (prev != AQI_CATEGORY_NONE && cat < prev &&
+        (uint32_t)aqi[i] + _category_hysteresis >= category_floor[prev]) {
+      // not clear of the boundary by the hysteresis yet, stay put
+      cat = prev;
+    }
+    if (cat != prev) {
+      _category[i] = cat;
+      events += raise(AQI_EVENT_CATEGORY, i, prev, cat);
+    }
+  }
+
+  // Threshold crossings
+  for (uint8_t i = 0; i < PM25AQI_EVENT_MAX_THRESHOLDS; i++) {
+    if (!_thresholds[i].enabled) {
+      continue;
+    }
+    uint16_t value = fieldValue(data, _thresholds[i].field);
+    uint16_t level = _thresholds[i].level;
+    if (!_thresholds[i].above && value >= level) {
+      _thresholds[i].above = true;
+      events += raise(AQI_EVENT_THRESHOLD_RISE, i, level, value);
+    } else if (_thresholds[i].above &&
+               value < level - _thresholds[i].hysteresis) {
+      _thresholds[i].above = false;
+      events += raise(AQI_EVENT_THRESHOLD_FALL, i, level, value);
+    }
+  }
+
+  // Rate of change
+  uint16_t value = fieldValue(data, _spike_field);
+  if (_spike_delta && _have_previous) {
+    uint16_t change = (value > _last_spike_value) ? value - _last_spike_value
+                                                  : _last_spike_value - value;
+    if (change > _spike_delta) {
+      events += raise(AQI_EVENT_SPIKE, _spike_field, _last_spike_value, value);
+    }
+  }
+  _last_spike_value = value;
+
+  // Stuck sensor, counted as identical frames in a row
+  uint16_t hash = frameHash(data);
+  if (_have_previous && hash == _last_hash) {
+    if (_same_count < 0xFFFF) {
+      _same_count++;
+    }
+    if (_stuck_frames && _same_count == _stuck_frames) {
+      events += raise(AQI_EVENT_STUCK, 0, 0, _same_count);
+    }
+  } else {
+    if (_stuck_frames && _same_count >= _stuck_frames) {
+      events += raise(AQI_EVENT_UNSTUCK, 0, _same_count, 1);
+    }
+    _same_count = 1;
+  }
+  _last_hash = hash;
+
+  _have_previous = true;
+  return events;
+}
@@ -0,0 +1,115 @@
+/*!
+ * @file Adafruit_AQIEvents.h
+ *
+ * Event detection over the stream of PM25_AQI_Data frames returned by
+ * Adafruit_PM25AQI::read(), so that only changes need to be reported.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_AQIEVENTS_H
+#define ADAFRUIT_AQIEVENTS_H
+#include "Adafruit_PM25AQI.h"
+
+#define PM25AQI_EVENT_MAX_THRESHOLDS 4 ///< Number of threshold slots
+#define AQI_CATEGORY_NONE 0xFF          ///< No frame seen yet
+
+/** Kinds of event raised by Adafruit_AQIEvents **/
+typedef enum {
+  AQI_EVENT_CATEGORY,       ///< AQI category changed on one of the scales
+  AQI_EVENT_THRESHOLD_RISE, ///< Field rose to or above a threshold
+  AQI_EVENT_THRESHOLD_FALL, ///< Field fell below threshold minus hysteresis
+  AQI_EVENT_SPIKE,          ///< Field changed by more than the spike delta
+  AQI_EVENT_STUCK,          ///< Sensor output has not changed for N frames
+  AQI_EVENT_UNSTUCK,        ///< Sensor output changed again after being stuck
+} aqi_event_type_t;
+
+/** AQI scales tracked for category changes **/
+typedef enum {
+  AQI_SCALE_PM25_US,     ///< aqi_pm25_us
+  AQI_SCALE_PM100_US,    ///< aqi_pm100_us
+  AQI_SCALE_PM25_CHINA,  ///< aqi_pm25_china
+  AQI_SCALE_PM100_CHINA, ///< aqi_pm100_china
+  AQI_SCALE_COUNT,       ///< Number of scales
+} aqi_scale_t;
+
+/** Fields of PM25_AQI_Data that thresholds and spikes can watch **/
+typedef enum {
+  AQI_FIELD_PM10_ENV,        ///< pm10_env
+  AQI_FIELD_PM25_ENV,        ///< pm25_env
+  AQI_FIELD_PM100_ENV,       ///< pm100_env
+  AQI_FIELD_PARTICLES_03UM,  ///< particles_03um
+  AQI_FIELD_AQI_PM25_US,     ///< aqi_pm25_us
+  AQI_FIELD_AQI_PM100_US,    ///< aqi_pm100_us
+  AQI_FIELD_AQI_PM25_CHINA,  ///< aqi_pm25_china
+  AQI_FIELD_AQI_PM100_CHINA, ///< aqi_pm100_china
+} aqi_field_t;
+
+/** An event passed to the callback **/
+typedef struct {
+  aqi_event_type_t type; ///< What happened
+  uint8_t source;        ///< Scale, threshold slot or field (see event type)
+  uint16_t previous;     ///< Old category, threshold level, value or count
+  uint16_t current;      ///< New category, value or frame count
+} aqi_event_t;
+
+/** Event callback, gets the context passed to setCallback() **/
+typedef void (*aqi_event_callback_t)(const aqi_event_t *event, void *context);
+
+/*!
+ *  @brief  Watches successive PM25_AQI_Data frames and raises events on AQI
+ *          category changes, threshold crossings, spikes and a stuck sensor.
+ *          Each update() is O(1) and the state is a few dozen bytes.
+ */
+class Adafruit_AQIEvents {
+public:
+  Adafruit_AQIEvents();
+  void setCallback(aqi_event_callback_t callback, void *context = nullptr);
+  void setCategoryHysteresis(uint8_t aqi_points);
+  bool setThreshold(uint8_t slot, aqi_field_t field, uint16_t level,
+                    uint16_t hysteresis = 0);
+  bool clearThreshold(uint8_t slot);
+  void setSpike(aqi_field_t field, uint16_t delta);
+  void setStuckFrames(uint16_t frames);
+  uint8_t update(const PM25_AQI_Data *data);
+  void reset();
+  uint8_t category(aqi_scale_t scale);
+
+  static uint8_t aqiCategory(uint16_t aqi);
+  static uint16_t fieldValue(const PM25_AQI_Data *data, aqi_field_t field);
+
+private:
+  uint8_t raise(aqi_event_type_t type, uint8_t source, uint16_t previous,
+                uint16_t current);
+  static uint16_t frameHash(const PM25_AQI_Data *data);
+
+  aqi_event_callback_t _callback = nullptr;
+  void *_context = nullptr;
+
+  uint8_t _category[AQI_SCALE_COUNT];
+  uint8_t _category_hysteresis = 0;
+
+  struct {
+    aqi_field_t field;
+    uint16_t level;
+    uint16_t hysteresis;
+    bool enabled;
+    bool above;
+  } _thresholds[PM25AQI_EVENT_MAX_THRESHOLDS];
+
+  aqi_field_t _spike_field = AQI_FIELD_PM25_ENV;
+  uint16_t _spike_delta = 0;
+
+  uint16_t _stuck_frames = 0;
+  uint16_t _same_count = 0;
+  uint16_t _last_hash = 0;
+  uint16_t _last_spike_value = 0;
+  bool _have_previous = false;
+};
+
+#endif // ADAFRUIT_AQIEVENTS_H
@@ -0,0 +1,321 @@
+/*!
+ * @file Adafruit_AQIFusion.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_AQIFusion.h"
+
+// Frames are combined word by word, as the struct is all uint16_t
+#define FUSION_FIRST_WORD 1 ///< First word combined, pm10_standard
+#define FUSION_LAST_WORD 12 ///< Last word combined, particles_100um
+#define FUSION_PM25_WORD 5  ///< Checked for disagreement, pm25_env
+#define FUSION_PM100_WORD 6 ///< Checked for disagreement, pm100_env
+
+/*!
+ *  @brief  Instantiates a new fusion of several sensors
+ *  @param  sensors
+ *          Array of sensors, already begun, for poll() to read. May be
+ *          nullptr if the sketch calls update() itself.
+ *  @param  count
+ *          Number of sensors, up to PM25AQI_FUSION_MAX_SENSORS
+ */
+Adafruit_AQIFusion::Adafruit_AQIFusion(Adafruit_PM25AQI **sensors,
+                                       uint8_t count) {
+  _sensors = sensors;
+  _count = min(count, (uint8_t)PM25AQI_FUSION_MAX_SENSORS);
+  for (uint8_t i = 0; i < PM25AQI_FUSION_MAX_SENSORS; i++) {
+    _timestamps[i] = 0;
+    _jumps[i] = 0;
+    _trust[i] = PM25AQI_FUSION_MAX_TRUST;
+  }
+}
+
+/*!
+ *  @brief  Reads every sensor once and stores the good frames
+ *  @return Number of sensors read successfully
+ */
+uint8_t Adafruit_AQIFusion::poll() {
+  PM25_AQI_Data data;
+  uint8_t good = 0;
+
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_sensors && _sensors[i] && _sensors[i]->read(&data)) {
+      update(i, &data, millis());
+      good++;
+    }
+  }
+  return good;
+}
+
+/*!
+ *  @brief  Stores a frame read from one of the sensors, for when the sketch
+ *          does the reading itself
+ *  @param  sensor
+ *          Index of the sensor the frame came from
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct read from it
+ *  @param  timestamp
+ *          millis() when the frame was read
+ *  @return True if the sensor index is valid, false otherwise
+ */
+bool Adafruit_AQIFusion::update(uint8_t sensor, const PM25_AQI_Data *data,
+                                uint32_t timestamp) {
+  if (sensor >= _count || !data) {
+    return false;
+  }
+  // How far this sensor moved on its own, the larger of the PM2.5 and PM10
+  // changes. Real air moves all the sensors at a site together.
+  _jumps[sensor] = 0;
+  if (_have & (1 << sensor)) {
+    const uint8_t checked[] = {FUSION_PM25_WORD, FUSION_PM100_WORD};
+    for (uint8_t f = 0; f < sizeof(checked); f++) {
+      uint16_t before = ((const uint16_t *)&_frames[sensor])[checked[f]];
+      uint16_t after = ((const uint16_t *)data)[checked[f]];
+      uint16_t jump = (after > before) ? after - before : before - after;
+      _jumps[sensor] = max(_jumps[sensor], jump);
+    }
+  }
+  _frames[sensor] = *data;
+  _timestamps[sensor] = timestamp;
+  _have |= 1 << sensor;
+  return true;
+}
+
+/*!
+ *  @brief  Sets how old a sensor's frame may be and still be used, which
+ *          lines up sensors that report at slightly different times
+ *  @param  ms
+ *          Maximum age in milliseconds
+ */
+void Adafruit_AQIFusion::setMaxAge(uint32_t ms) { _max_age = ms; }
+
+/*!
+ *  @brief  Sets how far a sensor may be from the median before it is left
+ *          out. The limit is the largest of 4.5 median absolute deviations,
+ *          min_ugm3 and percent of the median.
+ *  @param  min_ugm3
+ *          Smallest limit in ug/m3, so that agreeing sensors with a tiny
+ *          spread at low concentrations are not flagged
+ *  @param  percent
+ *          Smallest limit as a percentage of the median
+ */
+void Adafruit_AQIFusion::setOutlierLimit(uint16_t min_ugm3, uint8_t percent) {
+  _min_limit = min_ugm3;
+  _percent_limit = percent;
+}
+
+/*!
+ *  @brief  Gets a sensor's trust score
+ *  @param  sensor
+ *          Index of the sensor
+ *  @return 0 (never agrees) to PM25AQI_FUSION_MAX_TRUST (always agrees)
+ */
+uint8_t Adafruit_AQIFusion::trust(uint8_t sensor) {
+  if (sensor >= _count) {
+    return 0;
+  }
+  return _trust[sensor];
+}
+
+/*!
+ *  @brief  Checks if a sensor was left out of the last consensus because it
+ *          disagreed with the others
+ *  @param  sensor
+ *          Index of the sensor
+ *  @return True if it was an outlier
+ */
+bool Adafruit_AQIFusion::isOutlier(uint8_t sensor) {
+  return (sensor < _count) && (_outliers & (1 << sensor));
+}
+
+/*!
+ *  @brief  Gets how many sensors went into the last consensus
+ *  @return Number of sensors
+ */
+uint8_t Adafruit_AQIFusion::used() { return _used; }
+
+/*!
+ *  @brief  Sorts a few values in place and returns their median
+ *  @param  values
+ *          Values to sort
+ *  @param  count
+ *          Number of values, at least 1
+ *  @return The median, averaging the middle two for an even count
+ */
+uint16_t Adafruit_AQIFusion::median(uint16_t *values, uint8_t count) {
+  // insertion sort, there are only ever a handful of values
+  for (uint8_t i = 1; i < count; i++) {
+    uint16_t v = values[i];
+    int8_t j = i - 1;
+    while (j >= 0 && values[j] > v) {
+      values[j + 1] = values[j];
+      j--;
+    }
+    values[j + 1] = v;
+  }
+  if (count & 1) {
+    return values[count / 2];
+  }
+  return ((uint32_t)values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+/*!
+ *  @brief  Works out how far from the median a sensor may be
+ *  @param  median
+ *          Median across sensors
+ *  @param  mad
+ *          Median absolute deviation across sensors
+ *  @return Allowed deviation
+ */
+uint16_t Adafruit_AQIFusion::outlierLimit(uint16_t median, uint16_t mad) {
+  // 3 standard deviations, the MAD of normal data is ~0.67 sigma
+  uint32_t limit = (uint32_t)mad * 9 / 2;
+  limit = max(limit, (uint32_t)_min_limit);
+  limit = max(limit, (uint32_t)median * _percent_limit / 100);
+  return min(limit, (uint32_t)0xFFFF);
+}
+
+/*!
+ *  @brief  Combines the sensors' latest frames into one, using millis() as
+ *          the current time
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to fill with the consensus
+ *  @return True if at least one sensor had a recent enough frame
+ */
+bool Adafruit_AQIFusion::fuse(PM25_AQI_Data *data) {
+  return fuse(data, millis());
+}
+
+/*!
+ *  @brief  Combines the sensors' latest frames into one. Each field is the
+ *          median across the sensors that agree. Call once per reading
+ *          cycle, as this also updates the trust scores.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to fill with the consensus
+ *  @param  now
+ *          Current time, in the same units as the update() timestamps
+ *  @return True if at least one sensor had a recent enough frame and was
+ *          not left out. Of two sensors that disagree, exactly one is left
+ *          out, see the class description for how it is picked.
+ */
+bool Adafruit_AQIFusion::fuse(PM25_AQI_Data *data, uint32_t now) {
+  uint16_t values[PM25AQI_FUSION_MAX_SENSORS];
+  uint16_t deviations[PM25AQI_FUSION_MAX_SENSORS];
+  uint8_t fresh = 0, count = 0, disagree = 0;
+
+  if (!data) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < _count; i++) {
+    if ((_have & (1 << i)) && (now - _timestamps[i] <= _max_age)) {
+      fresh |= 1 << i;
+      count++;
+    }
+  }
+
+  // Check PM2.5 and PM10 against the median of all the fresh sensors
+  const uint8_t checked[] = {FUSION_PM25_WORD, FUSION_PM100_WORD};
+  for (uint8_t f = 0; f < sizeof(checked) && count > 1; f++) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (fresh & (1 << i)) {
+        values[n++] = ((const uint16_t *)&_frames[i])[checked[f]];
+      }
+    }
+    uint16_t med = median(values, n);
+    n = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (fresh & (1 << i)) {
+        uint16_t v = ((const uint16_t *)&_frames[i])[checked[f]];
+        deviations[n++] = (v > med) ? v - med : med - v;
+      }
+    }
+    // with only two sensors the MAD is always half their spread, so only
+    // the fixed limits apply
+    uint16_t mad = (n >= 3) ? median(deviations, n) : 0;
+    uint16_t limit = outlierLimit(med, mad);
+    for (uint8_t i = 0; i < _count; i++) {
+      if (fresh & (1 << i)) {
+        uint16_t v = ((const uint16_t *)&_frames[i])[checked[f]];
+        if (((v > med) ? v - med : med - v) > limit) {
+          disagree |= 1 << i;
+        }
+      }
+    }
+  }
+
+  _outliers = 0;
+  if (count >= 3) {
+    _outliers = disagree;
+  } else if (count == 2 && disagree) {
+    // Can't tell which of two is wrong from the data, trust history decides
+    uint8_t a = 0xFF, b = 0xFF;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (fresh & (1 << i)) {
+        if (a == 0xFF) {
+          a = i;
+        } else {
+          b = i;
+        }
+      }
+    }
+    // On equal trust, blame the one that jumped away from its own last
+    // reading, and failing that the higher index. Either way the scores
+    // split and the next disagreement is settled by trust alone.
+    bool a_wins;
+    if (_trust[a] != _trust[b]) {
+      a_wins = _trust[a] > _trust[b];
+    } else {
+      a_wins = _jumps[a] <= _jumps[b];
+    }
+    _outliers = a_wins ? 1 << b : 1 << a;
+  }
+
+  // Trust goes up while agreeing, down fast while left out, slowly while
+  // not reporting
+  for (uint8_t i = 0; i < _count; i++) {
+    if (!(fresh & (1 << i))) {
+      _trust[i] -= (_trust[i] + 15) / 16;
+    } else if (_outliers & (1 << i)) {
+      _trust[i] -= (_trust[i] + 3) / 4;
+    } else {
+      _trust[i] += (PM25AQI_FUSION_MAX_TRUST - _trust[i] + 7) / 8;
+    }
+  }
+
+  uint8_t inliers = fresh & ~_outliers;
+  _used = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (inliers & (1 << i)) {
+      if (_used == 0) {
+        *data = _frames[i]; // framelen, version/error from the first one
+        data->checksum = 0;
+      }
+      _used++;
+    }
+  }
+  if (_used == 0) {
+    return false;
+  }
+
+  uint16_t *words = (uint16_t *)data;
+  for (uint8_t w = FUSION_FIRST_WORD; w <= FUSION_LAST_WORD; w++) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (inliers & (1 << i)) {
+        values[n++] = ((const uint16_t *)&_frames[i])[w];
+      }
+    }
+    words[w] = median(values, n);
+  }
+
+  _aqi_utils.ConvertAQIData(data);
+  return true;
+}
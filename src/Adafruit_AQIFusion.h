@@ -0,0 +1,67 @@
+/*!
+ * @file Adafruit_AQIFusion.h
+ *
+ * Combines readings from two or more redundant PM sensors at one site into
+ * a single consensus reading, flagging a sensor that disagrees with the
+ * others.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_AQIFUSION_H
+#define ADAFRUIT_AQIFUSION_H
+#include "Adafruit_PM25AQI.h"
+
+#define PM25AQI_FUSION_MAX_SENSORS 4 ///< Most sensors that can be fused
+#define PM25AQI_FUSION_MAX_TRUST 100 ///< Trust score of a well behaved sensor
+
+/*!
+ *  @brief  Keeps the latest frame from each sensor and produces a consensus
+ *          frame from the ones that are recent enough. With three or more
+ *          sensors, one whose PM2.5 or PM10 is too far from the median
+ *          (measured in median absolute deviations) is left out. With two
+ *          that disagree, the one with the lower trust score is left out.
+ *          On equal trust, the one whose own reading jumped further since
+ *          its previous frame is left out, and failing that the one with
+ *          the higher index, so the first sensor acts as the primary. Each
+ *          sensor's trust score rises while it agrees and falls while it is
+ *          left out or goes quiet.
+ */
+class Adafruit_AQIFusion {
+public:
+  Adafruit_AQIFusion(Adafruit_PM25AQI **sensors, uint8_t count);
+  uint8_t poll();
+  bool update(uint8_t sensor, const PM25_AQI_Data *data, uint32_t timestamp);
+  bool fuse(PM25_AQI_Data *data);
+  bool fuse(PM25_AQI_Data *data, uint32_t now);
+  void setMaxAge(uint32_t ms);
+  void setOutlierLimit(uint16_t min_ugm3, uint8_t percent);
+  uint8_t trust(uint8_t sensor);
+  bool isOutlier(uint8_t sensor);
+  uint8_t used();
+
+private:
+  uint16_t outlierLimit(uint16_t median, uint16_t mad);
+  static uint16_t median(uint16_t *values, uint8_t count);
+
+  Adafruit_PM25AQI **_sensors;
+  uint8_t _count;
+  PM25_AQI_Data _frames[PM25AQI_FUSION_MAX_SENSORS];
+  uint32_t _timestamps[PM25AQI_FUSION_MAX_SENSORS];
+  uint8_t _trust[PM25AQI_FUSION_MAX_SENSORS];
+  uint16_t _jumps[PM25AQI_FUSION_MAX_SENSORS];
+  uint8_t _outliers = 0; ///< Bitmask of sensors left out of the last fuse()
+  uint8_t _have = 0;     ///< Bitmask of sensors with a frame
+  uint8_t _used = 0;
+  uint32_t _max_age = 3000;
+  uint16_t _min_limit = 5;
+  uint8_t _percent_limit = 25;
+  Adafruit_AQIUtils _aqi_utils;
+};
+
+#endif // ADAFRUIT_AQIFUSION_H
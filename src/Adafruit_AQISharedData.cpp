@@ -0,0 +1,127 @@
+/*!
+ * @file Adafruit_AQISharedData.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_AQISharedData.h"
+#ifdef ARDUINO
+#include "Adafruit_PM25AQI.h"
+#endif
+
+#ifdef __AVR__
+// No reordering in hardware, only stop the compiler from doing it
+#define AQI_BARRIER() __asm__ __volatile__("" ::: "memory") ///< Memory barrier
+#else
+#define AQI_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST) ///< Full fence
+#endif
+
+#define AQI_FRAME_WORDS                                                        \
+  (sizeof(PM25_AQI_Data) / sizeof(uint16_t)) ///< Words copied per frame
+
+/*!
+ *  @brief  Instantiates a new shared frame store
+ *  @param  sensor
+ *          Optional sensor for acquire() to read from, must already be begun
+ */
+Adafruit_AQISharedData::Adafruit_AQISharedData(Adafruit_PM25AQI *sensor) {
+  _sensor = sensor;
+}
+
+/*!
+ *  @brief  Reads the sensor and publishes the frame if it is valid. Only
+ *          call this from the one task that owns the sensor.
+ *  @return True if a new frame was published, false if the read failed
+ */
+bool Adafruit_AQISharedData::acquire() {
+#ifdef ARDUINO
+  PM25_AQI_Data data;
+
+  if (_sensor && _sensor->read(&data)) {
+    publish(&data);
+    return true;
+  }
+#endif
+  return false;
+}
+
+/*!
+ *  @brief  Publishes a frame to the readers. Only one task may publish.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to publish
+ */
+void Adafruit_AQISharedData::publish(const PM25_AQI_Data *data) {
+  const uint16_t *words = (const uint16_t *)data;
+
+  if (!data) {
+    return;
+  }
+
+  _sequence = _sequence + 1; // odd, write in progress
+  AQI_BARRIER();
+  for (uint8_t i = 0; i < AQI_FRAME_WORDS; i++) {
+    _frame[i] = words[i];
+  }
+  AQI_BARRIER();
+  aqi_seq_t next = _sequence + 1;
+  _sequence = next ? next : 2; // even, frame consistent. 0 means no frame
+}
+
+/*!
+ *  @brief  Copies out the latest published frame. Safe from any number of
+ *          tasks at once, never blocks the publisher and never touches the
+ *          bus. Gives up after PM25AQI_SHARED_MAX_RETRIES torn copies, so a
+ *          reader that preempted publish() on a single core returns instead
+ *          of spinning until the writer runs again.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to fill
+ *  @param  sequence
+ *          Optional, set to the frame's sequence number. It goes up by 2
+ *          per frame, skipping 0 when it wraps, so compare it with the last
+ *          one to spot new frames.
+ *  @return True if a frame was copied, false if none has been published yet
+ *          or a publish was in progress on every try. data may hold a torn
+ *          frame when false is returned.
+ */
+bool Adafruit_AQISharedData::latest(PM25_AQI_Data *data, aqi_seq_t *sequence) {
+  uint16_t *words = (uint16_t *)data;
+  aqi_seq_t before, after;
+  uint8_t tries = 0;
+
+  if (!data) {
+    return false;
+  }
+
+  do {
+    if (tries++ == PM25AQI_SHARED_MAX_RETRIES) {
+      return false; // the writer is stuck mid publish, let it run
+    }
+    before = _sequence;
+    if (before == 0) {
+      return false; // nothing published, _frame is uninitialised
+    }
+    AQI_BARRIER();
+    for (uint8_t i = 0; i < AQI_FRAME_WORDS; i++) {
+      words[i] = _frame[i];
+    }
+    AQI_BARRIER();
+    after = _sequence;
+  } while ((before & 1) || before != after);
+
+  if (sequence) {
+    *sequence = after;
+  }
+  return after != 0;
+}
+
+/*!
+ *  @brief  Gets the current sequence number, to check for a new frame
+ *          without copying it
+ *  @return Sequence number
+ */
+aqi_seq_t Adafruit_AQISharedData::sequence() { return _sequence; }
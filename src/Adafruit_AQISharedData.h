@@ -0,0 +1,58 @@
+/*!
+ * @file Adafruit_AQISharedData.h
+ *
+ * Lets one task own the sensor and publish each validated frame, while any
+ * number of other tasks (display, logger, uplink...) read the latest frame
+ * without touching the bus or taking a lock.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_AQISHAREDDATA_H
+#define ADAFRUIT_AQISHAREDDATA_H
+#include "Adafruit_PM25AQI_Data.h"
+
+class Adafruit_PM25AQI; ///< Forward declaration
+
+#ifdef __AVR__
+// Single core, and only 8 bit loads are atomic
+typedef uint8_t aqi_seq_t; ///< Sequence counter
+#else
+typedef uint32_t aqi_seq_t; ///< Sequence counter
+#endif
+
+#define PM25AQI_SHARED_MAX_RETRIES 4 ///< Copies latest() tries, then fails
+
+/*!
+ *  @brief  Single writer, many reader frame store using a sequence lock.
+ *          The writer makes the sequence odd, copies the frame in, then
+ *          makes it even again. Readers copy the frame out and retry if the
+ *          sequence was odd or changed meanwhile, up to
+ *          PM25AQI_SHARED_MAX_RETRIES times.
+ *
+ *          On a single core, a reader that preempts the writer mid publish()
+ *          cannot get a consistent frame until it yields and the writer
+ *          finishes. Give the publishing task a priority at least as
+ *          high as any reader's, or expect latest() to return false while a
+ *          publish is interrupted, and try again after yielding.
+ */
+class Adafruit_AQISharedData {
+public:
+  Adafruit_AQISharedData(Adafruit_PM25AQI *sensor = nullptr);
+  bool acquire();
+  void publish(const PM25_AQI_Data *data);
+  bool latest(PM25_AQI_Data *data, aqi_seq_t *sequence = nullptr);
+  aqi_seq_t sequence();
+
+private:
+  Adafruit_PM25AQI *_sensor;
+  volatile aqi_seq_t _sequence = 0;
+  volatile uint16_t _frame[sizeof(PM25_AQI_Data) / sizeof(uint16_t)];
+};
+
+#endif // ADAFRUIT_AQISHAREDDATA_H
@@ -0,0 +1,170 @@
+/*!
+ * @file Adafruit_AQITables.h
+ *
+ * Precomputed AQI lookup tables used by Adafruit_AQIUtils when the
+ * PM25AQI_USE_AQI_LUT option is enabled. Each table holds the low byte of the
+ * AQI for every integer concentration in the valid range; AQI values are
+ * monotonic, so the high byte is recovered by comparing the index against
+ * the first concentration whose AQI is >= 256.
+ *
+ * The tables reproduce the results of the pm*_aqi_* float conversions
+ * exactly for integer inputs. Regenerate them if those breakpoints change.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_AQITABLES_H
+#define ADAFRUIT_AQITABLES_H
+#ifdef ARDUINO
+#include "Arduino.h"
+#else
+#include <stdint.h>
+#endif
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#elif defined(ESP8266) || defined(ESP32)
+#include <pgmspace.h>
+#endif
+
+#ifndef PROGMEM
+#define PROGMEM ///< Host builds keep the tables in ordinary const data
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr)) ///< Flat memory
+#endif
+
+#define AQI_PM25_US_LUT_LEN 501  ///< Entries in aqi_pm25_us_lut
+#define AQI_PM25_US_LUT_HI 206   ///< First index of aqi_pm25_us_lut >= 256
+#define AQI_PM100_US_LUT_LEN 605 ///< Entries in aqi_pm100_us_lut
+#define AQI_PM100_US_LUT_HI 394  ///< First index of aqi_pm100_us_lut >= 256
+#define AQI_CHINA_LUT_LEN 501    ///< Entries in aqi_china_lut
+#define AQI_CHINA_LUT_HI 206     ///< First index of aqi_china_lut >= 256
+
+/** US EPA PM2.5 AQI, low byte, indexed by ug/m3 (0-500) */
+static const uint8_t aqi_pm25_us_lut[] PROGMEM = {
+      0,   4,   8,  13,  17,  21,  25,  29,  33,  38,  42,  46,  50,  53,  55,
+     57,  59,  61,  63,  66,  68,  70,  72,  74,  76,  78,  80,  82,  84,  87,
+     89,  91,  93,  95,  97,  99, 102, 105, 107, 110, 112, 115, 117, 119, 122,
+    124, 127, 129, 132, 134, 137, 139, 142, 144, 147, 149, 151, 152, 152, 153,
+    153, 154, 154, 155, 155, 156, 156, 157, 157, 158, 158, 159, 160, 160, 161,
+    161, 162, 162, 163, 163, 164, 164, 165, 165, 166, 166, 167, 167, 168, 168,
+    169, 169, 170, 170, 171, 171, 172, 172, 173, 173, 174, 174, 175, 176, 176,
+    177, 177, 178, 178, 179, 179, 180, 180, 181, 181, 182, 182, 183, 183, 184,
+    184, 185, 185, 186, 186, 187, 187, 188, 188, 189, 189, 190, 190, 191, 192,
+    192, 193, 193, 194, 194, 195, 195, 196, 196, 197, 197, 198, 198, 199, 199,
+    200, 201, 202, 203, 204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214,
+    215, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225, 226, 227, 228, 229,
+    230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244,
+    245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255,   0,   1,   2,   3,
+      4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,  16,  17,  18,
+     19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,
+     34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
+     49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,
+     64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,
+     79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,
+     94,  95,  96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107, 108,
+    109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123,
+    124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138,
+    139, 140, 141, 142, 143, 144, 145, 146, 147, 147, 148, 149, 149, 150, 151,
+    151, 152, 153, 153, 154, 155, 155, 156, 157, 157, 158, 159, 159, 160, 161,
+    161, 162, 163, 163, 164, 164, 165, 166, 166, 167, 168, 168, 169, 170, 170,
+    171, 172, 172, 173, 174, 174, 175, 176, 176, 177, 178, 178, 179, 180, 180,
+    181, 182, 182, 183, 184, 184, 185, 186, 186, 187, 188, 188, 189, 190, 190,
+    191, 192, 192, 193, 194, 194, 195, 196, 196, 197, 198, 198, 199, 199, 200,
+    201, 201, 202, 203, 203, 204, 205, 205, 206, 207, 207, 208, 209, 209, 210,
+    211, 211, 212, 213, 213, 214, 215, 215, 216, 217, 217, 218, 219, 219, 220,
+    221, 221, 222, 223, 223, 224, 225, 225, 226, 227, 227, 228, 229, 229, 230,
+    231, 231, 232, 233, 233, 234, 234, 235, 236, 236, 237, 238, 238, 239, 240,
+    240, 241, 242, 242, 243, 244,
+};
+
+/** US EPA PM10 AQI, low byte, indexed by ug/m3 (0-604) */
+static const uint8_t aqi_pm100_us_lut[] PROGMEM = {
+      0,   1,   2,   3,   4,   5,   5,   6,   7,   8,   9,  10,  11,  12,  13,
+     14,  15,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  25,  26,
+     27,  28,  29,  30,  31,  32,  33,  34,  35,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  45,  46,  47,  48,  49,  51,  51,  52,  52,  53,
+     53,  54,  54,  55,  55,  56,  56,  57,  57,  58,  58,  59,  59,  60,  60,
+     61,  61,  62,  62,  63,  63,  64,  64,  65,  65,  66,  66,  67,  67,  68,
+     68,  69,  69,  70,  70,  71,  71,  72,  72,  73,  73,  74,  74,  75,  75,
+     76,  76,  76,  77,  77,  78,  78,  79,  79,  80,  80,  81,  81,  82,  82,
+     83,  83,  84,  84,  85,  85,  86,  86,  87,  87,  88,  88,  89,  89,  90,
+     90,  91,  91,  92,  92,  93,  93,  94,  94,  95,  95,  96,  96,  97,  97,
+     98,  98,  99,  99, 100, 101, 101, 102, 102, 103, 103, 104, 104, 105, 105,
+    106, 106, 107, 107, 108, 108, 109, 109, 110, 110, 111, 111, 112, 112, 113,
+    113, 114, 114, 115, 115, 116, 116, 117, 117, 118, 118, 119, 119, 120, 120,
+    121, 121, 122, 122, 123, 123, 124, 124, 125, 125, 126, 126, 126, 127, 127,
+    128, 128, 129, 129, 130, 130, 131, 131, 132, 132, 133, 133, 134, 134, 135,
+    135, 136, 136, 137, 137, 138, 138, 139, 139, 140, 140, 141, 141, 142, 142,
+    143, 143, 144, 144, 145, 145, 146, 146, 147, 147, 148, 148, 149, 149, 150,
+    151, 151, 152, 152, 153, 153, 154, 154, 155, 155, 156, 156, 157, 157, 158,
+    158, 159, 159, 160, 160, 161, 161, 162, 162, 163, 163, 164, 164, 165, 165,
+    166, 166, 167, 167, 168, 168, 169, 169, 170, 170, 171, 171, 172, 172, 173,
+    173, 174, 174, 175, 175, 176, 176, 176, 177, 177, 178, 178, 179, 179, 180,
+    180, 181, 181, 182, 182, 183, 183, 184, 184, 185, 185, 186, 186, 187, 187,
+    188, 188, 189, 189, 190, 190, 191, 191, 192, 192, 193, 193, 194, 194, 195,
+    195, 196, 196, 197, 197, 198, 198, 199, 199, 200, 201, 202, 204, 205, 207,
+    208, 209, 211, 212, 214, 215, 217, 218, 219, 221, 222, 224, 225, 226, 228,
+    229, 231, 232, 234, 235, 236, 238, 239, 241, 242, 243, 245, 246, 248, 249,
+    251, 252, 253, 255,   0,   2,   3,   4,   6,   7,   9,  10,  11,  13,  14,
+     16,  17,  19,  20,  21,  23,  24,  26,  27,  28,  30,  31,  33,  34,  36,
+     37,  38,  40,  41,  43,  45,  46,  47,  49,  50,  51,  52,  54,  55,  56,
+     57,  59,  60,  61,  62,  64,  65,  66,  67,  69,  70,  71,  72,  73,  75,
+     76,  77,  78,  80,  81,  82,  83,  85,  86,  87,  88,  90,  91,  92,  93,
+     95,  96,  97,  98,  99, 101, 102, 103, 104, 106, 107, 108, 109, 111, 112,
+    113, 114, 116, 117, 118, 119, 120, 122, 123, 124, 125, 127, 128, 129, 130,
+    132, 133, 134, 135, 137, 138, 139, 140, 142, 143, 145, 146, 147, 148, 149,
+    150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164,
+    165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179,
+    180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
+    195, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208,
+    209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223,
+    224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238,
+    239, 240, 241, 242, 243,
+};
+
+/** China PM2.5/PM10 AQI, low byte, indexed by ug/m3 (0-500) */
+static const uint8_t aqi_china_lut[] PROGMEM = {
+      0,   1,   3,   4,   6,   7,   9,  10,  11,  13,  14,  16,  17,  19,  20,
+     21,  23,  24,  26,  27,  29,  30,  31,  33,  34,  36,  37,  39,  40,  41,
+     43,  44,  46,  47,  49,  50,  52,  53,  55,  56,  57,  58,  60,  61,  62,
+     63,  64,  66,  67,  68,  69,  71,  72,  73,  74,  76,  77,  78,  79,  80,
+     82,  83,  84,  85,  87,  88,  89,  90,  91,  93,  94,  95,  96,  98,  99,
+    100, 102, 103, 105, 106, 107, 108, 110, 111, 112, 113, 114, 116, 117, 118,
+    119, 121, 122, 123, 124, 126, 127, 128, 129, 130, 132, 133, 134, 135, 137,
+    138, 139, 140, 141, 143, 144, 145, 146, 148, 149, 150, 152, 154, 155, 157,
+    158, 159, 161, 162, 164, 165, 166, 168, 169, 171, 172, 173, 175, 176, 178,
+    179, 180, 182, 183, 185, 186, 187, 189, 190, 192, 193, 194, 196, 197, 199,
+    200, 202, 203, 204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215,
+    216, 217, 218, 219, 220, 221, 222, 223, 224, 225, 226, 227, 228, 229, 230,
+    231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245,
+    246, 247, 248, 249, 250, 251, 251, 252, 253, 254, 255,   0,   1,   2,   3,
+      4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,  16,  17,  18,
+     19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,
+     34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  46,  47,  48,  49,
+     50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,
+     65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,
+     80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,  94,
+     95,  95,  96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107, 108,
+    109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123,
+    124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138,
+    139, 140, 141, 142, 143, 144, 146, 146, 147, 148, 148, 149, 150, 150, 151,
+    152, 152, 153, 154, 154, 155, 156, 156, 157, 158, 158, 159, 160, 160, 161,
+    162, 162, 163, 163, 164, 165, 165, 166, 167, 167, 168, 169, 169, 170, 171,
+    171, 172, 173, 173, 174, 175, 175, 176, 177, 177, 178, 179, 179, 180, 181,
+    181, 182, 183, 183, 184, 185, 185, 186, 187, 187, 188, 189, 189, 190, 191,
+    191, 192, 193, 193, 194, 195, 195, 196, 196, 197, 198, 198, 199, 200, 200,
+    201, 202, 202, 203, 204, 204, 205, 206, 206, 207, 208, 208, 209, 210, 210,
+    211, 212, 212, 213, 214, 214, 215, 216, 216, 217, 218, 218, 219, 220, 220,
+    221, 222, 222, 223, 224, 224, 225, 226, 226, 227, 228, 228, 229, 229, 230,
+    231, 231, 232, 233, 233, 234, 235, 235, 236, 237, 237, 238, 239, 239, 240,
+    241, 241, 242, 243, 243, 244,
+};
+
+#endif // ADAFRUIT_AQITABLES_H
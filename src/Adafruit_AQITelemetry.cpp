@@ -0,0 +1,295 @@
+/*!
+ * @file Adafruit_AQITelemetry.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_AQITelemetry.h"
+#include <string.h>
+
+// The packer indexes PM25_AQI_Data as an array of 16 bit words
+static_assert(sizeof(PM25_AQI_Data) == AQI_PACK_FIELD_COUNT * sizeof(uint16_t),
+              "PM25_AQI_Data must be packed 16 bit words");
+
+/*!
+ *  @brief  Writes the low bits of a value into a bit stream, MSB first
+ *  @param  buffer
+ *          Output buffer, must be zeroed beforehand
+ *  @param  bitpos
+ *          Current bit position, advanced by bits
+ *  @param  value
+ *          Value to write
+ *  @param  bits
+ *          Number of bits to write, 1 to 16
+ */
+static void put_bits(uint8_t *buffer, size_t *bitpos, uint16_t value,
+                     uint8_t bits) {
+  for (int8_t b = bits - 1; b >= 0; b--) {
+    if (value & (1 << b)) {
+      buffer[*bitpos / 8] |= 0x80 >> (*bitpos % 8);
+    }
+    (*bitpos)++;
+  }
+}
+
+/*!
+ *  @brief  Reads bits from a bit stream, MSB first
+ *  @param  buffer
+ *          Input buffer
+ *  @param  bitpos
+ *          Current bit position, advanced by bits
+ *  @param  bits
+ *          Number of bits to read, 1 to 16
+ *  @return The value read
+ */
+static uint16_t get_bits(const uint8_t *buffer, size_t *bitpos,
+                         uint8_t bits) {
+  uint16_t value = 0;
+  for (uint8_t b = 0; b < bits; b++) {
+    value <<= 1;
+    if (buffer[*bitpos / 8] & (0x80 >> (*bitpos % 8))) {
+      value |= 1;
+    }
+    (*bitpos)++;
+  }
+  return value;
+}
+
+/*!
+ *  @brief  Checks a field can be packed. framelen and checksum only describe
+ *          the serial frame, so they are not data worth sending.
+ *  @param  field
+ *          Word index into PM25_AQI_Data
+ *  @return True if the field is one of aqi_pack_field_t
+ */
+static bool packable(uint8_t field) {
+  // word 14 is the checksum, which has no aqi_pack_field_t
+  return field != 0 && field != 14 && field < AQI_PACK_FIELD_COUNT;
+}
+
+/*!
+ *  @brief  Instantiates a new packer sending pm10_env, pm25_env and
+ *          pm100_env at full precision with 6 bit deltas.
+ */
+Adafruit_AQITelemetry::Adafruit_AQITelemetry() {
+  memset(_shift, 0, sizeof(_shift));
+  memset(_delta_bits, 0, sizeof(_delta_bits));
+  setField(AQI_PACK_PM10_ENV);
+  setField(AQI_PACK_PM25_ENV);
+  setField(AQI_PACK_PM100_ENV);
+  reset();
+}
+
+/*!
+ *  @brief  Adds a field to the packet, or changes its precision
+ *  @param  field
+ *          The field to send
+ *  @param  shift
+ *          Number of low bits to drop, 0 to 15. Each one halves the
+ *          precision and saves a bit in keyframes.
+ *  @param  delta_bits
+ *          Bits used for the signed change between packets, 1 to 16. Larger
+ *          changes force a keyframe.
+ *  @return True if the arguments are valid, false otherwise
+ */
+bool Adafruit_AQITelemetry::setField(aqi_pack_field_t field, uint8_t shift,
+                                     uint8_t delta_bits) {
+  if (!packable(field) || shift > 15 || delta_bits == 0 || delta_bits > 16) {
+    return false;
+  }
+  _shift[field] = shift;
+  _delta_bits[field] = delta_bits;
+  reset();
+  return true;
+}
+
+/*!
+ *  @brief  Removes a field from the packet
+ *  @param  field
+ *          The field to stop sending
+ *  @return True if the field is valid, false otherwise
+ */
+bool Adafruit_AQITelemetry::clearField(aqi_pack_field_t field) {
+  if (!packable(field)) {
+    return false;
+  }
+  _delta_bits[field] = 0;
+  reset();
+  return true;
+}
+
+/*!
+ *  @brief  Sets how often a keyframe is sent even when deltas would fit, so
+ *          a receiver that lost a packet can resync.
+ *  @param  packets
+ *          Packets between keyframes, 1 sends only keyframes
+ */
+void Adafruit_AQITelemetry::setKeyframeInterval(uint8_t packets) {
+  _keyframe_interval = packets ? packets : 1;
+}
+
+/*!
+ *  @brief  Gets the size of a keyframe with the current field setup
+ *  @return Payload size in bytes
+ */
+size_t Adafruit_AQITelemetry::keyframeSize() {
+  size_t bits = 8;
+  for (uint8_t i = 0; i < AQI_PACK_FIELD_COUNT; i++) {
+    if (_delta_bits[i]) {
+      bits += 16 - _shift[i];
+    }
+  }
+  return (bits + 7) / 8;
+}
+
+/*!
+ *  @brief  Gets the size of a delta packet with the current field setup
+ *  @return Payload size in bytes
+ */
+size_t Adafruit_AQITelemetry::deltaSize() {
+  size_t bits = 8;
+  for (uint8_t i = 0; i < AQI_PACK_FIELD_COUNT; i++) {
+    bits += _delta_bits[i];
+  }
+  return (bits + 7) / 8;
+}
+
+/*!
+ *  @brief  Forgets the previous packet. The next encode() sends a keyframe
+ *          and the next decode() needs one.
+ */
+void Adafruit_AQITelemetry::reset() {
+  memset(_last, 0, sizeof(_last));
+  _since_keyframe = 0;
+  _have_last = false;
+}
+
+/*!
+ *  @brief  Packs a frame into a payload, as a delta against the previous one
+ *          when every enabled field's change fits, otherwise as a keyframe.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to send
+ *  @param  payload
+ *          Output buffer, PM25AQI_TELEMETRY_MAX_PAYLOAD bytes is always
+ *          enough
+ *  @param  maxlen
+ *          Size of the output buffer
+ *  @return Number of payload bytes written, 0 if the buffer is too small
+ */
+size_t Adafruit_AQITelemetry::encode(const PM25_AQI_Data *data,
+                                     uint8_t *payload, size_t maxlen) {
+  if (!data || !payload) {
+    return 0;
+  }
+
+  const uint16_t *words = (const uint16_t *)data;
+  uint16_t quantized[AQI_PACK_FIELD_COUNT];
+  bool keyframe = !_have_last || (_since_keyframe >= _keyframe_interval - 1);
+
+  for (uint8_t i = 0; i < AQI_PACK_FIELD_COUNT; i++) {
+    if (!_delta_bits[i]) {
+      continue;
+    }
+    quantized[i] = words[i] >> _shift[i];
+    if (!keyframe && _delta_bits[i] < 16) {
+      int32_t delta = (int32_t)quantized[i] - _last[i];
+      int32_t limit = (int32_t)1 << (_delta_bits[i] - 1);
+      if (delta < -limit || delta >= limit) {
+        keyframe = true;
+      }
+    }
+  }
+
+  size_t len = keyframe ? keyframeSize() : deltaSize();
+  if (len > maxlen) {
+    return 0;
+  }
+  memset(payload, 0, len);
+
+  _sequence = (_sequence + 1) & 0x7F;
+  payload[0] = _sequence | (keyframe ? PM25AQI_TELEMETRY_KEYFRAME : 0);
+  size_t bitpos = 8;
+  for (uint8_t i = 0; i < AQI_PACK_FIELD_COUNT; i++) {
+    if (!_delta_bits[i]) {
+      continue;
+    }
+    if (keyframe) {
+      put_bits(payload, &bitpos, quantized[i], 16 - _shift[i]);
+    } else {
+      // two's complement, truncated to delta_bits
+      put_bits(payload, &bitpos, quantized[i] - _last[i], _delta_bits[i]);
+    }
+    _last[i] = quantized[i];
+  }
+
+  _since_keyframe = keyframe ? 0 : _since_keyframe + 1;
+  _have_last = true;
+  return len;
+}
+
+/*!
+ *  @brief  Unpacks a payload made by encode(). Fields that are not sent are
+ *          set to 0, quantized fields to the middle of their step.
+ *  @param  payload
+ *          Received payload
+ *  @param  len
+ *          Payload length in bytes
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to fill
+ *  @return True on success. False if the payload is malformed, or is a delta
+ *          that does not follow the last packet received (a packet was lost),
+ *          in which case decoding resumes at the next keyframe.
+ */
+bool Adafruit_AQITelemetry::decode(const uint8_t *payload, size_t len,
+                                   PM25_AQI_Data *data) {
+  if (!payload || !data || len < 1) {
+    return false;
+  }
+
+  bool keyframe = payload[0] & PM25AQI_TELEMETRY_KEYFRAME;
+  uint8_t sequence = payload[0] & 0x7F;
+  if (len != (keyframe ? keyframeSize() : deltaSize())) {
+    return false;
+  }
+  if (!keyframe && (!_have_last || sequence != ((_sequence + 1) & 0x7F))) {
+    _have_last = false;
+    return false;
+  }
+
+  size_t bitpos = 8;
+  for (uint8_t i = 0; i < AQI_PACK_FIELD_COUNT; i++) {
+    if (!_delta_bits[i]) {
+      continue;
+    }
+    if (keyframe) {
+      _last[i] = get_bits(payload, &bitpos, 16 - _shift[i]);
+    } else {
+      uint8_t bits = _delta_bits[i];
+      uint16_t delta = get_bits(payload, &bitpos, bits);
+      if (bits < 16 && (delta & (1 << (bits - 1)))) {
+        delta |= 0xFFFF << bits; // sign extend
+      }
+      _last[i] += delta;
+    }
+  }
+  _sequence = sequence;
+  _have_last = true;
+
+  memset(data, 0, sizeof(PM25_AQI_Data));
+  uint16_t *words = (uint16_t *)data;
+  for (uint8_t i = 0; i < AQI_PACK_FIELD_COUNT; i++) {
+    if (!_delta_bits[i]) {
+      continue;
+    }
+    words[i] = _last[i] << _shift[i];
+    if (_shift[i]) {
+      words[i] |= 1 << (_shift[i] - 1);
+    }
+  }
+  return true;
+}
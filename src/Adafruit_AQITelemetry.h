@@ -0,0 +1,83 @@
+/*!
+ * @file Adafruit_AQITelemetry.h
+ *
+ * Compact encoder/decoder for sending PM25_AQI_Data over low bandwidth links
+ * such as LoRa. Selected fields are quantized, delta encoded against the
+ * previous packet and bit packed. This file has no Arduino dependencies, so
+ * the same class decodes the payloads on a host or gateway.
+ *
+ * Packet layout, MSB first:
+ *  - 1 byte header: bit 7 set for a keyframe, bits 0-6 sequence number
+ *  - keyframe: each enabled field as (16 - shift) bits
+ *  - delta: each enabled field as a delta_bits two's complement difference
+ *    from the previous packet's quantized value
+ *
+ * Both ends must be configured with the same fields, shifts and delta_bits.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_AQITELEMETRY_H
+#define ADAFRUIT_AQITELEMETRY_H
+#include "Adafruit_PM25AQI_Data.h"
+#include <stddef.h>
+
+#define PM25AQI_TELEMETRY_MAX_PAYLOAD 35 ///< Header + all 17 fields, 16 bits
+#define PM25AQI_TELEMETRY_KEYFRAME 0x80  ///< Header bit marking a keyframe
+
+/** Fields that can be packed, numbered by their 16 bit word in the struct **/
+typedef enum {
+  AQI_PACK_PM10_STANDARD = 1,    ///< pm10_standard
+  AQI_PACK_PM25_STANDARD = 2,    ///< pm25_standard
+  AQI_PACK_PM100_STANDARD = 3,   ///< pm100_standard
+  AQI_PACK_PM10_ENV = 4,         ///< pm10_env
+  AQI_PACK_PM25_ENV = 5,         ///< pm25_env
+  AQI_PACK_PM100_ENV = 6,        ///< pm100_env
+  AQI_PACK_PARTICLES_03UM = 7,   ///< particles_03um
+  AQI_PACK_PARTICLES_05UM = 8,   ///< particles_05um
+  AQI_PACK_PARTICLES_10UM = 9,   ///< particles_10um
+  AQI_PACK_PARTICLES_25UM = 10,  ///< particles_25um
+  AQI_PACK_PARTICLES_50UM = 11,  ///< particles_50um
+  AQI_PACK_PARTICLES_100UM = 12, ///< particles_100um
+  AQI_PACK_UNUSED = 13,          ///< unused (version + error code)
+  AQI_PACK_AQI_PM25_US = 15,     ///< aqi_pm25_us
+  AQI_PACK_AQI_PM100_US = 16,    ///< aqi_pm100_us
+  AQI_PACK_AQI_PM25_CHINA = 17,  ///< aqi_pm25_china
+  AQI_PACK_AQI_PM100_CHINA = 18, ///< aqi_pm100_china
+  AQI_PACK_FIELD_COUNT = 19,     ///< Number of 16 bit words in the struct
+} aqi_pack_field_t;
+
+/*!
+ *  @brief  Packs PM25_AQI_Data into small payloads and unpacks them again.
+ *          Use one instance to encode and a separate one to decode, since
+ *          each keeps the previous packet's values.
+ */
+class Adafruit_AQITelemetry {
+public:
+  Adafruit_AQITelemetry();
+  bool setField(aqi_pack_field_t field, uint8_t shift = 0,
+                uint8_t delta_bits = 6);
+  bool clearField(aqi_pack_field_t field);
+  void setKeyframeInterval(uint8_t packets);
+  size_t keyframeSize();
+  size_t deltaSize();
+  size_t encode(const PM25_AQI_Data *data, uint8_t *payload, size_t maxlen);
+  bool decode(const uint8_t *payload, size_t len, PM25_AQI_Data *data);
+  void reset();
+
+private:
+  uint8_t _shift[AQI_PACK_FIELD_COUNT];
+  uint8_t _delta_bits[AQI_PACK_FIELD_COUNT]; ///< 0 when the field is unused
+  uint16_t _last[AQI_PACK_FIELD_COUNT];      ///< Quantized values last sent
+  uint8_t _keyframe_interval = 60;
+  uint8_t _since_keyframe = 0;
+  uint8_t _sequence = 0;
+  bool _have_last = false;
+};
+
+#endif // ADAFRUIT_AQITELEMETRY_H
@@ -15,6 +15,7 @@
  *
  */
 #include "Adafruit_AQIUtils.h"
+#include "Adafruit_AQITables.h"
 
 /*!
  *  @brief  Get AQI of PM2.5 in US standard
@@ -141,4 +142,91 @@ float Adafruit_AQIUtils::MapLinear(uint16_t aqi_high, uint16_t aqi_low,
           (aqi_high - aqi_low) +
       aqi_low;
   return f;
-}
\ No newline at end of file
+}
+
+/*!
+ *  @brief  Look up an AQI in one of the precomputed tables
+ *  @param  lut table of AQI low bytes, in PROGMEM
+ *  @param  len number of entries in the table
+ *  @param  hi first index whose AQI is >= 256
+ *  @param  concentration integer concentration in ug/m3, used as the index
+ *  @return AQI number, or ERR_AQI_OUT_OF_RANGE truncated to 16 bits (the same
+ * value the float conversions return) for out of range.
+ */
+static uint16_t lookup_aqi(const uint8_t *lut, uint16_t len, uint16_t hi,
+                           uint16_t concentration) {
+  if (concentration >= len) {
+    return (uint16_t)ERR_AQI_OUT_OF_RANGE;
+  }
+  uint16_t aqi = pgm_read_byte(&lut[concentration]);
+  if (concentration >= hi) {
+    aqi += 256;
+  }
+  return aqi;
+}
+
+/*!
+ *  @brief  Get AQI of PM2.5 in US standard from the lookup table
+ *  @param  concentration
+ *          the environmental concentration of pm2.5 in ug/m3
+ *  @return Same result as pm25_aqi_us() for the same integer concentration
+ */
+uint16_t Adafruit_AQIUtils::pm25_aqi_us_lut(uint16_t concentration) {
+  return lookup_aqi(aqi_pm25_us_lut, AQI_PM25_US_LUT_LEN, AQI_PM25_US_LUT_HI,
+                    concentration);
+}
+
+/*!
+ *  @brief  Get AQI of PM2.5 in China standard from the lookup table
+ *  @param  concentration
+ *          the environmental concentration of pm2.5 in ug/m3
+ *  @return Same result as pm25_aqi_china() for the same integer concentration
+ */
+uint16_t Adafruit_AQIUtils::pm25_aqi_china_lut(uint16_t concentration) {
+  return lookup_aqi(aqi_china_lut, AQI_CHINA_LUT_LEN, AQI_CHINA_LUT_HI,
+                    concentration);
+}
+
+/*!
+ *  @brief  Get AQI of PM10 in US standard from the lookup table
+ *  @param  concentration
+ *          the environmental concentration of pm10 in ug/m3
+ *  @return Same result as pm100_aqi_us() for the same integer concentration
+ */
+uint16_t Adafruit_AQIUtils::pm100_aqi_us_lut(uint16_t concentration) {
+  return lookup_aqi(aqi_pm100_us_lut, AQI_PM100_US_LUT_LEN,
+                    AQI_PM100_US_LUT_HI, concentration);
+}
+
+/*!
+ *  @brief  Get AQI of PM10 in China standard from the lookup table. The
+ * China PM2.5 and PM10 breakpoints are identical, so the table is shared.
+ *  @param  concentration
+ *          the environmental concentration of pm10 in ug/m3
+ *  @return Same result as pm100_aqi_china() for the same integer concentration
+ */
+uint16_t Adafruit_AQIUtils::pm100_aqi_china_lut(uint16_t concentration) {
+  return lookup_aqi(aqi_china_lut, AQI_CHINA_LUT_LEN, AQI_CHINA_LUT_HI,
+                    concentration);
+}
+
+/*!
+ *  @brief  Converts the PM2.5 raw data to country-specific AQI values
+ *          and fills the PM25_AQI_Data struct with the results. Uses the
+ *          lookup tables when PM25AQI_USE_AQI_LUT is defined.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct.
+ */
+void Adafruit_AQIUtils::ConvertAQIData(PM25_AQI_Data *data) {
+#ifdef PM25AQI_USE_AQI_LUT
+  data->aqi_pm25_us = pm25_aqi_us_lut(data->pm25_env);
+  data->aqi_pm25_china = pm25_aqi_china_lut(data->pm25_env);
+  data->aqi_pm100_us = pm100_aqi_us_lut(data->pm100_env);
+  data->aqi_pm100_china = pm100_aqi_china_lut(data->pm100_env);
+#else
+  data->aqi_pm25_us = pm25_aqi_us(data->pm25_env);
+  data->aqi_pm25_china = pm25_aqi_china(data->pm25_env);
+  data->aqi_pm100_us = pm100_aqi_us(data->pm100_env);
+  data->aqi_pm100_china = pm100_aqi_china(data->pm100_env);
+#endif
+}
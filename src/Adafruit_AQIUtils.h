@@ -16,11 +16,21 @@
  */
 #ifndef ADAFRUIT_AQIUTILS_H
 #define ADAFRUIT_AQIUTILS_H
+#ifdef ARDUINO
 #include "Arduino.h"
+#else
+#include <stdint.h> // host builds, the AQI math needs no Arduino core
+#endif
+#include "Adafruit_PM25AQI_Data.h"
 #include <math.h>
 
 #define ERR_AQI_OUT_OF_RANGE 99999 ///< AQI out of range
 
+// Uncomment (or pass -DPM25AQI_USE_AQI_LUT) to have ConvertAQIData() use the
+// precomputed lookup tables instead of the float conversions. Costs ~1.6KB
+// of flash, saves the floating point math on every read.
+// #define PM25AQI_USE_AQI_LUT
+
 class Adafruit_AQIUtils {
 public:
   float MapLinear(uint16_t aqi_high, uint16_t aqi_low, float conc_high,
@@ -29,5 +39,10 @@ public:
   uint16_t pm25_aqi_china(float concentration);
   uint16_t pm100_aqi_us(float concentration);
   uint16_t pm100_aqi_china(float concentration);
+  uint16_t pm25_aqi_us_lut(uint16_t concentration);
+  uint16_t pm25_aqi_china_lut(uint16_t concentration);
+  uint16_t pm100_aqi_us_lut(uint16_t concentration);
+  uint16_t pm100_aqi_china_lut(uint16_t concentration);
+  void ConvertAQIData(PM25_AQI_Data *data);
 };
 #endif // ADAFRUIT_AQIUTILS_CPP
@@ -35,7 +35,9 @@
 /*!
  *  @brief  Instantiates a new PM25AQI class
  */
-Adafruit_PM25AQI::Adafruit_PM25AQI() { _aqi_utils = new Adafruit_AQIUtils(); }
+Adafruit_PM25AQI::Adafruit_PM25AQI() {
+  _clock = Adafruit_PM25AQI_Clock::defaultClock();
+}
 
 /*!
  *  @brief  Default implementation of begin() - this is a no-op
@@ -47,11 +49,6 @@ bool Adafruit_PM25AQI::begin() {
 }
 
 Adafruit_PM25AQI::~Adafruit_PM25AQI() {
-  if (_aqi_utils) {
-    delete _aqi_utils;
-    _aqi_utils = nullptr;
-  }
-
   if (_pm25_i2c != nullptr) {
     delete _pm25_i2c;
     _pm25_i2c = nullptr;
@@ -70,19 +67,33 @@ Adafruit_PM25AQI::~Adafruit_PM25AQI() {
  *          Pointer to PM25_AQI_Data struct.
  */
 void Adafruit_PM25AQI::ConvertAQIData(PM25_AQI_Data *data) {
-  data->aqi_pm25_us = _aqi_utils->pm25_aqi_us(data->pm25_env);
-  data->aqi_pm25_china = _aqi_utils->pm25_aqi_china(data->pm25_env);
-  data->aqi_pm100_us = _aqi_utils->pm100_aqi_us(data->pm100_env);
-  data->aqi_pm100_china = _aqi_utils->pm100_aqi_china(data->pm100_env);
+  _aqi_utils.ConvertAQIData(data);
+}
+
+/*!
+ *  @brief  Sets the time source for the timeouts of begin_I2C(),
+ *          begin_UART() and read(data, timeout_ms). Defaults to millis()
+ *          and delay(). The I2C and UART transports read without waiting,
+ *          so they never use it.
+ *  @param  clock
+ *          Clock to use, must outlive this object
+ */
+void Adafruit_PM25AQI::setClock(Adafruit_PM25AQI_Clock *clock) {
+  if (clock == nullptr) {
+    clock = Adafruit_PM25AQI_Clock::defaultClock();
+  }
+  _clock = clock;
 }
 
 /*!
  *  @brief  Setups the hardware and detects a valid PMSA003I. Initializes I2C.
  *  @param  theWire
  *          Optional pointer to I2C interface, otherwise use Wire
+ *  @param  timeout_ms
+ *          How long to keep retrying while the sensor boots, 0 to try once
  *  @return True if PMSA003I found on I2C, False if something went wrong!
  */
-bool Adafruit_PM25AQI::begin_I2C(TwoWire *theWire) {
+bool Adafruit_PM25AQI::begin_I2C(TwoWire *theWire, uint32_t timeout_ms) {
   if (_pm25_i2c != nullptr) {
     return false;
   }
@@ -91,8 +102,19 @@ bool Adafruit_PM25AQI::begin_I2C(TwoWire *theWire) {
   if (!_pm25_i2c) {
     return false;
   }
+
   // Attempt to initialize the I2C PM2.5 sensor
-  return _pm25_i2c->begin(theWire);
+  uint32_t start = _clock->now();
+  while (!_pm25_i2c->begin(theWire)) {
+    if (_clock->elapsed(start) >= timeout_ms) {
+      // free the transport so begin_I2C() can be tried again
+      delete _pm25_i2c;
+      _pm25_i2c = nullptr;
+      return false;
+    }
+    _clock->sleep(10);
+  }
+  return true;
 }
 
 /*!
@@ -101,14 +123,29 @@ bool Adafruit_PM25AQI::begin_I2C(TwoWire *theWire) {
  *          Pointer to Stream (HardwareSerial/SoftwareSerial) interface
  *  @param  is_pm1006
  *         True the sensor is a Cubic PM1006, False otherwise.
- *  @return True
+ *  @param  timeout_ms
+ *          How long to wait for a first valid frame, 0 to not wait (a UART
+ *          sensor can't be detected without one)
+ *  @return True if set up, and a frame arrived in time if waiting for one
  */
-bool Adafruit_PM25AQI::begin_UART(Stream *theSerial, bool is_pm1006) {
+bool Adafruit_PM25AQI::begin_UART(Stream *theSerial, bool is_pm1006,
+                                  uint32_t timeout_ms) {
   if (_pm25_uart != nullptr) {
     return false;
   }
   _pm25_uart = new Adafruit_PM25AQI_UART(is_pm1006);
-  return _pm25_uart->begin(theSerial);
+  if (!_pm25_uart) {
+    return false;
+  }
+  PM25_AQI_Data data;
+  if (_pm25_uart->begin(theSerial) &&
+      (timeout_ms == 0 || read(&data, timeout_ms))) {
+    return true;
+  }
+  // free the transport so begin_UART() can be tried again
+  delete _pm25_uart;
+  _pm25_uart = nullptr;
+  return false;
 }
 
 /*!
@@ -125,4 +162,24 @@ bool Adafruit_PM25AQI::read(PM25_AQI_Data *data) {
     return _pm25_uart->read(data);
   }
   return false;
-}
\ No newline at end of file
+}
+
+/*!
+ *  @brief  Keeps trying to read until a valid frame arrives or the deadline
+ *          passes. The sensors send a frame about once a second.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data that will be filled by read()ing
+ *  @param  timeout_ms
+ *          Deadline in milliseconds, 0 to try once
+ *  @return True on successful read, false if the deadline passed
+ */
+bool Adafruit_PM25AQI::read(PM25_AQI_Data *data, uint32_t timeout_ms) {
+  uint32_t start = _clock->now();
+  while (!read(data)) {
+    if (_clock->elapsed(start) >= timeout_ms) {
+      return false;
+    }
+    _clock->sleep(1);
+  }
+  return true;
+}
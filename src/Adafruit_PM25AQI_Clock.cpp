@@ -0,0 +1,40 @@
+/*!
+ * @file Adafruit_PM25AQI_Clock.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_PM25AQI_Clock.h"
+#include "Arduino.h"
+
+/*!
+ *  @brief  Clock backed by the Arduino core's millis() and delay()
+ */
+class Adafruit_PM25AQI_ArduinoClock : public Adafruit_PM25AQI_Clock {
+public:
+  /*!
+   *  @brief  Gets the current time
+   *  @return millis()
+   */
+  uint32_t now() { return millis(); }
+  /*!
+   *  @brief  Waits, letting other tasks run
+   *  @param  ms
+   *          Milliseconds to wait
+   */
+  void sleep(uint32_t ms) { delay(ms); }
+};
+
+/*!
+ *  @brief  Gets the clock drivers use unless given another one
+ *  @return Shared clock backed by millis() and delay()
+ */
+Adafruit_PM25AQI_Clock *Adafruit_PM25AQI_Clock::defaultClock() {
+  static Adafruit_PM25AQI_ArduinoClock clock;
+  return &clock;
+}
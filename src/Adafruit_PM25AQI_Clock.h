@@ -0,0 +1,48 @@
+/*!
+ * @file Adafruit_PM25AQI_Clock.h
+ *
+ * Time source used by the PM25 AQI drivers for timeouts. The default wraps
+ * millis() and delay(); a sketch or host build can substitute its own, for
+ * example a virtual clock that lets tests run at full speed.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_PM25AQI_CLOCK_H
+#define ADAFRUIT_PM25AQI_CLOCK_H
+#include <stdint.h>
+
+/*!
+ *  @brief  Monotonic millisecond clock interface
+ */
+class Adafruit_PM25AQI_Clock {
+public:
+  virtual ~Adafruit_PM25AQI_Clock() {}
+  /*!
+   *  @brief  Gets the current time
+   *  @return Milliseconds since an arbitrary start, wrapping at 2^32
+   */
+  virtual uint32_t now() = 0;
+  /*!
+   *  @brief  Waits
+   *  @param  ms
+   *          Milliseconds to wait
+   */
+  virtual void sleep(uint32_t ms) = 0;
+  /*!
+   *  @brief  Gets the time since an earlier now(), correct across wraparound
+   *  @param  since
+   *          Earlier value of now()
+   *  @return Milliseconds elapsed
+   */
+  uint32_t elapsed(uint32_t since) { return now() - since; }
+
+  static Adafruit_PM25AQI_Clock *defaultClock();
+};
+
+#endif // ADAFRUIT_PM25AQI_CLOCK_H
@@ -0,0 +1,48 @@
+/*!
+ * @file Adafruit_PM25AQI_Data.h
+ *
+ * The decoded packet shared by all of the PM25 AQI drivers. It has no
+ * Arduino dependencies so it can also be used by host side tools.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Written by Ladyada for Adafruit Industries.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef ADAFRUIT_PM25AQI_DATA_H
+#define ADAFRUIT_PM25AQI_DATA_H
+#include <stdint.h>
+
+/**! Structure holding Plantower's standard packet **/
+typedef struct PMSAQIdata {
+  uint16_t framelen;       ///< How long this data chunk is
+  uint16_t pm10_standard,  ///< Standard PM1.0
+      pm25_standard,       ///< Standard PM2.5
+      pm100_standard;      ///< Standard PM10.0
+  uint16_t pm10_env,       ///< Environmental PM1.0
+      pm25_env,            ///< Environmental PM2.5
+      pm100_env;           ///< Environmental PM10.0
+  uint16_t particles_03um, ///< 0.3um Particle Count
+      particles_05um,      ///< 0.5um Particle Count
+      particles_10um,      ///< 1.0um Particle Count
+      particles_25um,      ///< 2.5um Particle Count
+      particles_50um,      ///< 5.0um Particle Count
+      particles_100um;     ///< 10.0um Particle Count
+  uint16_t unused;         ///< Unused (version + error code)
+
+  uint16_t checksum; ///< Packet checksum
+
+  // AQI conversion results:
+  uint16_t aqi_pm25_us;     ///< pm2.5 AQI of United States
+  uint16_t aqi_pm100_us;    ///< pm10 AQI of United States
+  uint16_t aqi_pm25_china;  ///< pm2.5 AQI of China
+  uint16_t aqi_pm100_china; ///< pm10 AQI of China
+
+} PM25_AQI_Data;
+
+#endif // ADAFRUIT_PM25AQI_DATA_H
@@ -46,47 +46,27 @@ bool Adafruit_PM25AQI_I2C::begin(TwoWire *theWire, uint8_t i2c_addr) {
  *  @return True on successful read, False if timed out or bad data.
  */
 bool Adafruit_PM25AQI_I2C::read(PM25_AQI_Data *data) {
-  uint8_t buffer[32];
-  size_t bufLen = sizeof(buffer);
-  uint16_t sum = 0;
+  uint8_t buffer[PM25AQI_FRAME_LEN];
 
-  if (!data && _i2c_dev == nullptr) {
+  if (!data || _i2c_dev == nullptr) {
     return false; // Objects improperly initialized, early-out
   }
 
-  if (!_i2c_dev->read(buffer, 32)) {
+  if (!_i2c_dev->read(buffer, sizeof(buffer))) {
     return false; // I2C read failed, early-out
   }
 
-  // Validate start byte is correct if using Adafruit PM sensors
-  if (buffer[0] != 0x42 || buffer[1] != 0x4d) {
+  // Validate header, length and checksum
+  if (!Adafruit_PM25AQI_Parser::valid(buffer)) {
     return false;
   }
 
-  // Calculate checksum
-  for (uint8_t i = 0; i < 30; i++) {
-    sum += buffer[i];
-  }
-
-  // Since header and checksum are OK, parse data from the buffer
-  // The data comes in endian'd, this solves it so it works on all platforms
-  uint16_t buffer_u16[15];
-  for (uint8_t i = 0; i < 15; i++) {
-    buffer_u16[i] = buffer[2 + i * 2 + 1];
-    buffer_u16[i] += (buffer[2 + i * 2] << 8);
-  }
-
   // put it into a nice struct :)
-  memcpy((void *)data, (void *)buffer_u16, 30);
-
-  // Validate checksum
-  if (sum != data->checksum) {
-    return false;
-  }
+  Adafruit_PM25AQI_Parser::decodePM25(buffer, data);
 
   // convert raw concentrations to AQI
   this->ConvertAQIData(data);
 
   // success!
   return true;
-}
\ No newline at end of file
+}
@@ -20,6 +20,7 @@
 #ifndef ADAFRUIT_PM25AQI_I2C_H
 #define ADAFRUIT_PM25AQI_I2C_H
 #include "Adafruit_PM25AQI.h"
+#include "Adafruit_PM25AQI_Parser.h"
 #include <Adafruit_I2CDevice.h>
 
 #define PMSA003I_DEFAULT_ADDRESS 0x12 ///< PMSA003I has only one I2C address
@@ -34,11 +35,11 @@ public:
   ~Adafruit_PM25AQI_I2C();
   bool begin(TwoWire *theWire = &Wire,
              uint8_t i2c_addr = PMSA003I_DEFAULT_ADDRESS);
+  using Adafruit_PM25AQI::read;
   virtual bool read(PM25_AQI_Data *data);
 
 private:
   Adafruit_I2CDevice *_i2c_dev = nullptr;
-  uint8_t _readbuffer[32];
 };
 
 #endif // ADAFRUIT_PM25AQI_I2C_H
@@ -0,0 +1,216 @@
+/*!
+ * @file Adafruit_PM25AQI_Parser.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_PM25AQI_Parser.h"
+#include <string.h>
+
+// Fixed leading bytes of each frame: start bytes plus length field
+static const uint8_t pm25_header[] = {0x42, 0x4D, 0x00, 0x1C};
+static const uint8_t pm1006_header[] = {0x16, 0x11, 0x0B};
+
+/*!
+ *  @brief  Instantiates a new parser
+ *  @param  is_pm1006
+ *          True to look for Cubic PM1006 frames, false for Plantower frames
+ */
+Adafruit_PM25AQI_Parser::Adafruit_PM25AQI_Parser(bool is_pm1006) {
+  _is_pm1006 = is_pm1006;
+}
+
+/*!
+ *  @brief  Drops any partial frame
+ */
+void Adafruit_PM25AQI_Parser::reset() {
+  _len = 0;
+  _complete = false;
+}
+
+/*!
+ *  @brief  Gets the length of the frames being parsed
+ *  @return PM25AQI_FRAME_LEN or PM1006_FRAME_LEN
+ */
+uint8_t Adafruit_PM25AQI_Parser::frameLength() {
+  return _is_pm1006 ? PM1006_FRAME_LEN : PM25AQI_FRAME_LEN;
+}
+
+/*!
+ *  @brief  Gets the number of bytes thrown away while looking for frames
+ *  @return Bytes discarded since the parser was created
+ */
+uint32_t Adafruit_PM25AQI_Parser::discarded() { return _discarded; }
+
+/*!
+ *  @brief  Gets the number of complete frames that failed their checksum
+ *  @return Bad frames since the parser was created
+ */
+uint32_t Adafruit_PM25AQI_Parser::badChecksums() { return _bad_checksums; }
+
+/*!
+ *  @brief  Adds the next byte from the stream
+ *  @param  c
+ *          Byte received
+ *  @return True if a valid frame is now complete and can be decode()d
+ */
+bool Adafruit_PM25AQI_Parser::push(uint8_t c) {
+  if (_complete) {
+    _len = 0;
+    _complete = false;
+  }
+  _buffer[_len++] = c;
+  return scan();
+}
+
+/*!
+ *  @brief  Drops the first buffered byte and everything up to the next
+ *          possible start byte
+ */
+void Adafruit_PM25AQI_Parser::dropToNextStart() {
+  uint8_t start = _is_pm1006 ? pm1006_header[0] : pm25_header[0];
+  uint8_t skip = 1;
+  while (skip < _len && _buffer[skip] != start) {
+    skip++;
+  }
+  memmove(_buffer, _buffer + skip, _len - skip);
+  _len -= skip;
+  _discarded += skip;
+}
+
+/*!
+ *  @brief  Checks the buffered bytes, dropping leading bytes until they are
+ *          a valid frame or a valid beginning of one. Each pass drops at
+ *          least one byte, so this is bounded by the buffer length.
+ *  @return True if the buffer holds a complete frame with a good checksum
+ */
+bool Adafruit_PM25AQI_Parser::scan() {
+  const uint8_t *header = _is_pm1006 ? pm1006_header : pm25_header;
+  uint8_t header_len = _is_pm1006 ? sizeof(pm1006_header) : sizeof(pm25_header);
+  uint8_t frame_len = frameLength();
+
+  while (_len > 0) {
+    bool match = true;
+    for (uint8_t i = 0; i < header_len && i < _len; i++) {
+      if (_buffer[i] != header[i]) {
+        match = false;
+        break;
+      }
+    }
+    if (!match) {
+      dropToNextStart();
+      continue;
+    }
+    if (_len < frame_len) {
+      return false; // good so far, wait for more
+    }
+    if (valid(_buffer, _is_pm1006)) {
+      _complete = true;
+      return true;
+    }
+    _bad_checksums++;
+    dropToNextStart();
+  }
+  return false;
+}
+
+/*!
+ *  @brief  Checks a whole frame's header and checksum, for transports such
+ *          as I2C that read a frame at a time and don't need to resync
+ *  @param  frame
+ *          PM25AQI_FRAME_LEN or PM1006_FRAME_LEN bytes
+ *  @param  is_pm1006
+ *          True for a Cubic PM1006 frame, false for a Plantower frame
+ *  @return True if the frame is good to decode
+ */
+bool Adafruit_PM25AQI_Parser::valid(const uint8_t *frame, bool is_pm1006) {
+  if (!frame) {
+    return false;
+  }
+  if (is_pm1006) {
+    if (memcmp(frame, pm1006_header, sizeof(pm1006_header)) != 0) {
+      return false;
+    }
+    // all bytes including the checksum sum to zero
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < PM1006_FRAME_LEN; i++) {
+      sum += frame[i];
+    }
+    return sum == 0;
+  }
+
+  if (memcmp(frame, pm25_header, sizeof(pm25_header)) != 0) {
+    return false;
+  }
+  // 16 bit sum of everything before the checksum
+  uint16_t sum = 0;
+  for (uint8_t i = 0; i < PM25AQI_FRAME_LEN - 2; i++) {
+    sum += frame[i];
+  }
+  uint16_t expected =
+      (frame[PM25AQI_FRAME_LEN - 2] << 8) | frame[PM25AQI_FRAME_LEN - 1];
+  return sum == expected;
+}
+
+/*!
+ *  @brief  Decodes the frame completed by the last push()
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to fill
+ *  @return True on success, false if no frame is complete
+ */
+bool Adafruit_PM25AQI_Parser::decode(PM25_AQI_Data *data) {
+  if (!_complete || !data) {
+    return false;
+  }
+  if (_is_pm1006) {
+    return decodePM1006(_buffer, data);
+  }
+  return decodePM25(_buffer, data);
+}
+
+/*!
+ *  @brief  Decodes a checksummed Plantower frame
+ *  @param  frame
+ *          PM25AQI_FRAME_LEN bytes, starting with 0x42 0x4D
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to fill, up to the checksum
+ *  @return True on success
+ */
+bool Adafruit_PM25AQI_Parser::decodePM25(const uint8_t *frame,
+                                         PM25_AQI_Data *data) {
+  if (!frame || !data) {
+    return false;
+  }
+
+  // The data comes in endian'd, this solves it so it works on all platforms
+  uint16_t *words = (uint16_t *)data;
+  for (uint8_t i = 0; i < 15; i++) {
+    words[i] = (frame[2 + i * 2] << 8) | frame[2 + i * 2 + 1];
+  }
+  return true;
+}
+
+/*!
+ *  @brief  Decodes a checksummed Cubic PM1006 frame
+ *  @param  frame
+ *          PM1006_FRAME_LEN bytes, starting with 0x16 0x11 0x0B
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to fill. The PM1006 only
+ *          produces a pm25_env reading.
+ *  @return True on success
+ */
+bool Adafruit_PM25AQI_Parser::decodePM1006(const uint8_t *frame,
+                                           PM25_AQI_Data *data) {
+  if (!frame || !data) {
+    return false;
+  }
+
+  data->pm25_env = (frame[5] << 8) | frame[6];
+  data->checksum = 0;
+  return true;
+}
@@ -0,0 +1,59 @@
+/*!
+ * @file Adafruit_PM25AQI_Parser.h
+ *
+ * Byte stream framer and decoder for the Plantower PM25 packet and the
+ * Cubic PM1006 packet. It has no Arduino dependencies, so it is shared by
+ * the UART driver, the I2C driver and host side tools.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_PM25AQI_PARSER_H
+#define ADAFRUIT_PM25AQI_PARSER_H
+#include "Adafruit_PM25AQI_Data.h"
+#include <stddef.h>
+
+#define PM25AQI_FRAME_LEN 32     ///< Plantower: 0x42 0x4D, length 28, data
+#define PM1006_FRAME_LEN 20      ///< Cubic: 0x16, length 17, 0x0B, data
+#define PM25AQI_MAX_FRAME_LEN 32 ///< Largest frame of either kind
+
+/*!
+ *  @brief  Finds frames in a byte stream one byte at a time. A byte is only
+ *          accepted while it matches the frame header (start bytes and
+ *          length), so garbage is dropped as it arrives. If a full frame
+ *          fails its checksum, the buffered bytes are rescanned from the
+ *          next start byte, so a false start byte inside a payload costs a
+ *          few bytes instead of a whole frame.
+ */
+class Adafruit_PM25AQI_Parser {
+public:
+  Adafruit_PM25AQI_Parser(bool is_pm1006 = false);
+  bool push(uint8_t c);
+  bool decode(PM25_AQI_Data *data);
+  void reset();
+  uint8_t frameLength();
+  uint32_t discarded();
+  uint32_t badChecksums();
+
+  static bool valid(const uint8_t *frame, bool is_pm1006 = false);
+  static bool decodePM25(const uint8_t *frame, PM25_AQI_Data *data);
+  static bool decodePM1006(const uint8_t *frame, PM25_AQI_Data *data);
+
+private:
+  bool scan();
+  void dropToNextStart();
+
+  uint8_t _buffer[PM25AQI_MAX_FRAME_LEN];
+  uint8_t _len = 0;
+  bool _complete = false;
+  bool _is_pm1006;
+  uint32_t _discarded = 0;
+  uint32_t _bad_checksums = 0;
+};
+
+#endif // ADAFRUIT_PM25AQI_PARSER_H
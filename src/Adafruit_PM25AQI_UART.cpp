@@ -22,7 +22,24 @@
  *  @param  serial
  *          Pointer to a Stream object (e.g., Serial, SoftwareSerial).
  */
-UARTDevice::UARTDevice(Stream *serial) { _serial_dev = serial; }
+UARTDevice::UARTDevice(Stream *serial) {
+  _serial_dev = serial;
+  _clock = Adafruit_PM25AQI_Clock::defaultClock();
+}
+
+/*!
+ *  @brief  Sets the time source used by uart_read() for its timeout
+ *  @param  clock
+ *          Clock to use
+ */
+void UARTDevice::setClock(Adafruit_PM25AQI_Clock *clock) { _clock = clock; }
+
+/*!
+ *  @brief  Sets how long uart_read() waits for the requested bytes
+ *  @param  timeout_ms
+ *          Timeout in milliseconds, 100 by default
+ */
+void UARTDevice::setTimeout(uint32_t timeout_ms) { _timeout_ms = timeout_ms; }
 
 /*!
  *  @brief  Dtor for the UARTDevice class.
@@ -112,16 +129,17 @@ bool UARTDevice::uart_write(void *thiz, const uint8_t *buffer, size_t len) {
  *          Pointer to the buffer where data will be stored.
  *  @param  len
  *          Length of the data to read.
- *  @return True if data is read successfully, false if a timeout occured.
+ *  @return True if data is read successfully, false if the bytes did not
+ * arrive within the timeout.
  */
 bool UARTDevice::uart_read(void *thiz, uint8_t *buffer, size_t len) {
   UARTDevice *dev = (UARTDevice *)thiz;
-  uint16_t timeout = 100;
-  while (dev->_serial_dev->available() < len && timeout--) {
-    delay(1);
-  }
-  if (timeout == 0) {
-    return false;
+  uint32_t start = dev->_clock->now();
+  while ((size_t)dev->_serial_dev->available() < len) {
+    if (dev->_clock->elapsed(start) >= dev->_timeout_ms) {
+      return false;
+    }
+    dev->_clock->sleep(1);
   }
   for (size_t i = 0; i < len; i++) {
     buffer[i] = dev->_serial_dev->read();
@@ -131,187 +149,38 @@ bool UARTDevice::uart_read(void *thiz, uint8_t *buffer, size_t len) {
 
 /*!
  *  @brief  Ctor for the Adafruit_PM25AQI_UART class.
+ *  @param  is_pm1006
+ *          True for a Cubic PM1006, false for a Plantower sensor
  */
-Adafruit_PM25AQI_UART::Adafruit_PM25AQI_UART(bool is_pm1006) {
-  _is_pm1006 = is_pm1006;
-}
+Adafruit_PM25AQI_UART::Adafruit_PM25AQI_UART(bool is_pm1006)
+    : _reader(is_pm1006) {}
 
 /*!
  *  @brief  Dtor for the Adafruit_PM25AQI_UART class.
  */
-Adafruit_PM25AQI_UART::~Adafruit_PM25AQI_UART() {
-  if (_uart_dev != nullptr) {
-    delete _uart_dev;
-    _uart_dev = nullptr;
-  }
-}
+Adafruit_PM25AQI_UART::~Adafruit_PM25AQI_UART() {}
 
 /*!
- *  @brief  Attempts to initialize a PMSA003I sensor on a specified I2C bus.
+ *  @brief  Attempts to initialize a UART PM2.5 sensor on a Stream. Frames
+ * are read straight from the Stream's own receive buffer, nothing is
+ * allocated.
+ *  @param  theSerial
+ *          Pointer to Stream (HardwareSerial/SoftwareSerial) interface
  *  @return True if successfully initialized, false otherwise.
  */
 bool Adafruit_PM25AQI_UART::begin(Stream *theSerial) {
-  if (_serial_dev != nullptr || _uart_dev != nullptr)
-    return false; // already initialized
-
-  _serial_dev = theSerial;
-  _uart_dev = new UARTDevice(_serial_dev);
-  return _uart_dev->CreateDevice();
+  return _reader.begin(theSerial);
 }
 
 /*!
- *  @brief  Attempts to read PM2.5 data from an Adafruit AQ sensor.
+ *  @brief  Attempts to read PM2.5 data from the AQ sensor. Bytes already
+ * received are fed to the frame parser, which keeps any partial frame
+ * between calls, so this never waits for the sensor and consumes at most
+ * PM25AQI_UART_MAX_SCAN bytes.
  *  @param  data
  *          Pointer to PM25_AQI_Data struct.
- *  @return True on successful read, False if timed out or bad data.
- */
-bool Adafruit_PM25AQI_UART::read_PM25(PM25_AQI_Data *data) {
-  uint8_t buffer[32];
-  size_t bufLen = sizeof(buffer);
-  uint16_t sum = 0;
-  uint8_t csum = 0;
-
-  if (!data || !_uart_dev) {
-    return false;
-  }
-
-  if (!_uart_dev->available()) {
-    return false;
-  }
-
-  int skipped = 0;
-  while ((skipped < 32) && (_uart_dev->peek() != 0x42)) {
-    _uart_dev->read();
-    skipped++;
-    if (!_uart_dev->available()) {
-      return false;
-    }
-  }
-
-  // Check for the start character in the stream
-  if ((_uart_dev->peek() != 0x42)) {
-    _uart_dev->read();
-    return false;
-  }
-
-  // Are there enough bytes to read from?
-  if (_uart_dev->available() < bufLen)
-    return false;
-
-  // Read all available bytes from the serial stream
-  _uart_dev->getGenericDevice()->read(buffer, bufLen);
-
-  // Validate start byte is correct if using Adafruit PM sensors
-  if (buffer[0] != 0x42 || buffer[1] != 0x4d)
-    return false;
-
-  // Calculate checksum
-  for (uint8_t i = 0; i < 30; i++) {
-    sum += buffer[i];
-  }
-
-  // Since header and checksum are OK, parse data from the buffer
-  // The data comes in endian'd, this solves it so it works on all platforms
-  uint16_t buffer_u16[15];
-  for (uint8_t i = 0; i < 15; i++) {
-    buffer_u16[i] = buffer[2 + i * 2 + 1];
-    buffer_u16[i] += (buffer[2 + i * 2] << 8);
-  }
-  // put it into a nice struct :)
-  memcpy((void *)data, (void *)buffer_u16, 30);
-
-  // Validate checksum
-  if (sum != data->checksum)
-    return false;
-
-  // convert raw concentrations to AQI using parent class method
-  this->ConvertAQIData(data);
-
-  // success!
-  return true;
-}
-
-/*!
- *  @brief  Attempts to read PM2.5 data from the Cubic PM1006 sensor.
- *  @param  data
- *          Pointer to PM25_AQI_Data struct.
- *  @return True on successful read, False if timed out or bad data.
- */
-bool Adafruit_PM25AQI_UART::read_PM1006(PM25_AQI_Data *data) {
-  uint8_t buffer[20];
-  size_t bufLen = 20;
-  uint16_t sum = 0;
-  uint8_t csum = 0;
-
-  if (!data || !_uart_dev) {
-    return false;
-  }
-
-  if (!_uart_dev->available()) {
-    return false;
-  }
-
-  int skipped = 0;
-  while ((skipped < 32) && (_uart_dev->peek() != 0x16) &&
-         (_uart_dev->peek() != 0x42)) {
-    _uart_dev->read();
-    skipped++;
-    if (!_uart_dev->available()) {
-      return false;
-    }
-  }
-
-  // Check for the start character in the stream
-  if ((_uart_dev->peek() == 16)) {
-    _uart_dev->read();
-    return false;
-  }
-
-  // Are there enough bytes to read from?
-  if (_uart_dev->available() < bufLen) {
-    return false;
-  }
-
-  // Read all available bytes from the serial stream
-  _uart_dev->getGenericDevice()->read(buffer, bufLen);
-
-  // Validate start header is correct if using Cubic PM1006 sensor
-  if (buffer[0] != 0x16 || buffer[1] != 0x11 || buffer[2] != 0x0B) {
-    return false;
-  }
-
-  // Calculate checksum
-  for (uint8_t i = 0; i < bufLen; i++) {
-    csum += buffer[i];
-  }
-
-  // Since header and checksum are OK, parse data from the buffer
-  // (Cubic PM1006 sensor only produces a pm25_env reading)
-  data->pm25_env = (buffer[5] << 8) | buffer[6];
-  data->checksum = sum;
-
-  // Validate checksum
-  if (csum != 0) {
-    return false;
-  }
-
-  // convert raw concentrations to AQI using parent class method
-  this->ConvertAQIData(data);
-
-  // success!
-  return true;
-}
-
-/*!
- *  @brief  Attempts to read PM2.5 data from the AQ sensor.
- *  @param  data
- *          Pointer to PM25_AQI_Data struct.
- *  @return True on successful read, False if timed out or bad data.
+ *  @return True on successful read, False if no complete, valid frame yet.
  */
 bool Adafruit_PM25AQI_UART::read(PM25_AQI_Data *data) {
-  if (_is_pm1006) {
-    return read_PM1006(data);
-  } else {
-    return read_PM25(data);
-  }
-}
\ No newline at end of file
+  return _reader.read(data);
+}
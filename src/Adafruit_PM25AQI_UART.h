@@ -21,10 +21,17 @@
 #define ADAFRUIT_PM25AQI_UART_H
 #include "Adafruit_GenericDevice.h"
 #include "Adafruit_PM25AQI.h"
+#include "Adafruit_PM25AQI_UARTReader.h"
 
 #define ADAFRUIT_PM_START_BYTE 0x42 ///< Start byte for Adafruit's PM25 sensors
 #define PMSA003I_START_BYTE 0x16    ///< Start byte for Cubic PM1006
 
+/*!
+ *  @brief  Standalone adapter exposing a Stream as an Adafruit_GenericDevice.
+ *          This is a legacy API kept for sketches that use it directly; the
+ *          PM2.5 drivers no longer create one and read the Stream through
+ *          Adafruit_PM25AQI_UARTReader instead.
+ */
 class UARTDevice {
 public:
   UARTDevice(Stream *serial);
@@ -36,30 +43,32 @@ public:
   static bool uart_write(void *thiz, const uint8_t *buffer, size_t len);
   static bool uart_read(void *thiz, uint8_t *buffer, size_t len);
   Adafruit_GenericDevice *getGenericDevice() { return _generic_dev; }
+  void setClock(Adafruit_PM25AQI_Clock *clock);
+  void setTimeout(uint32_t timeout_ms);
 
 private:
   Adafruit_GenericDevice *_generic_dev = nullptr;
   Stream *_serial_dev = nullptr;
+  Adafruit_PM25AQI_Clock *_clock = nullptr;
+  uint32_t _timeout_ms = 100;
 };
 
 /*!
  *  @brief  UART interface for the Adafruit PM2.5 Air Quality Sensor
-            and Plantower PMSA003I Sensor.
+            and Plantower PMSA003I Sensor. The virtual destructor it
+            inherits links operator delete and free(); on a board with
+            little RAM use Adafruit_PM25AQI_UARTReader directly.
  */
 class Adafruit_PM25AQI_UART : public Adafruit_PM25AQI {
 public:
   Adafruit_PM25AQI_UART(bool is_pm1006 = false);
   ~Adafruit_PM25AQI_UART();
   bool begin(Stream *theSerial);
+  using Adafruit_PM25AQI::read;
   virtual bool read(PM25_AQI_Data *data);
 
 private:
-  bool read_PM25(PM25_AQI_Data *data);
-  bool read_PM1006(PM25_AQI_Data *data);
-  Stream *_serial_dev = nullptr;
-  UARTDevice *_uart_dev = nullptr;
-  uint8_t _readbuffer[32];
-  bool _is_pm1006;
+  Adafruit_PM25AQI_UARTReader _reader;
 };
 
 #endif // ADAFRUIT_PM25AQI_UART_H
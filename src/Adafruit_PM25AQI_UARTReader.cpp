@@ -0,0 +1,63 @@
+/*!
+ * @file Adafruit_PM25AQI_UARTReader.cpp
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#include "Adafruit_PM25AQI_UARTReader.h"
+
+/*!
+ *  @brief  Instantiates a new reader
+ *  @param  is_pm1006
+ *          True for a Cubic PM1006, false for a Plantower sensor
+ */
+Adafruit_PM25AQI_UARTReader::Adafruit_PM25AQI_UARTReader(bool is_pm1006)
+    : _parser(is_pm1006) {}
+
+/*!
+ *  @brief  Starts reading frames from a Stream. They are read straight from
+ *          the Stream's own receive buffer, nothing is allocated.
+ *  @param  theSerial
+ *          Pointer to Stream (HardwareSerial/SoftwareSerial) interface
+ *  @return True if successfully initialized, false if already begun or no
+ *          Stream was given
+ */
+bool Adafruit_PM25AQI_UARTReader::begin(Stream *theSerial) {
+  if (_serial_dev != nullptr || theSerial == nullptr) {
+    return false;
+  }
+  _serial_dev = theSerial;
+  return true;
+}
+
+/*!
+ *  @brief  Feeds the bytes already received to the frame parser, which
+ *          keeps any partial frame between calls. Never waits for the
+ *          sensor and consumes at most PM25AQI_UART_MAX_SCAN bytes.
+ *  @param  data
+ *          Pointer to PM25_AQI_Data struct to fill, with AQI values
+ *  @return True on successful read, false if no complete, valid frame yet
+ */
+bool Adafruit_PM25AQI_UARTReader::read(PM25_AQI_Data *data) {
+  if (!data || !_serial_dev) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < PM25AQI_UART_MAX_SCAN; i++) {
+    int c = _serial_dev->read();
+    if (c < 0) {
+      return false; // nothing more buffered
+    }
+    if (_parser.push(c)) {
+      _parser.decode(data);
+      _aqi_utils.ConvertAQIData(data);
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,43 @@
+/*!
+ * @file Adafruit_PM25AQI_UARTReader.h
+ *
+ * Minimal UART reader for boards with little RAM: a frame parser and the
+ * AQI conversion on a Stream, with no base class, no virtual functions and
+ * nothing allocated.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * @section license License
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef ADAFRUIT_PM25AQI_UARTREADER_H
+#define ADAFRUIT_PM25AQI_UARTREADER_H
+#include "Adafruit_AQIUtils.h"
+#include "Adafruit_PM25AQI_Parser.h"
+#include "Arduino.h"
+
+#define PM25AQI_UART_MAX_SCAN 64 ///< Most bytes one read() will consume
+
+/*!
+ *  @brief  Reads PM25 / PM1006 frames from a Stream without blocking. It
+ *          does not derive from Adafruit_PM25AQI, so a sketch that only
+ *          uses this class links no vtable, and no operator delete or
+ *          free() through a virtual destructor.
+ *          Adafruit_PM25AQI_UART reads through one of these.
+ */
+class Adafruit_PM25AQI_UARTReader {
+public:
+  Adafruit_PM25AQI_UARTReader(bool is_pm1006 = false);
+  bool begin(Stream *theSerial);
+  bool read(PM25_AQI_Data *data);
+
+private:
+  Stream *_serial_dev = nullptr;
+  Adafruit_PM25AQI_Parser _parser;
+  Adafruit_AQIUtils _aqi_utils;
+};
+
+#endif // ADAFRUIT_PM25AQI_UARTREADER_H